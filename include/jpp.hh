@@ -13,14 +13,133 @@
 
 #include <string>
 #include <map>
+#include <memory_resource>
 #include <stdexcept>
 #include <any>
 #include <cctype>
 #include <vector>
+#include <iterator>
+#include <string_view>
+#include <variant>
+#include <cstdint>
+#include <typeinfo>
+#include <memory>
+#include <compare>
+#include <algorithm>
+#include <numeric>
+#include <charconv>
+#include <system_error>
+#include <bit>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <atomic>
+#include <ostream>
+#include <cstdio>
+#include <cmath>
+#include <cerrno>
+#include <type_traits>
+#include <shared_mutex>
+#include <functional>
+#include <limits>
+#include <chrono>
+#include <utility>
+#include <tuple>
+#include <optional>
+#ifdef _WIN32
+#include <io.h>
+#include <fstream>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#if !defined(JPP_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define JPP_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define JPP_TARGET_AVX2
+#else
+#define JPP_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
 
 #define l_object std::vector<std::pair<std::string, std::any>>
 #define l_array std::vector<std::any>
 
+#define JPP_EXPAND(x) x
+#define JPP_FIELD_1(Type, field) Jpp::make_field<Type>(#field, &Type::field)
+#define JPP_FIELD_2(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_1(Type, __VA_ARGS__))
+#define JPP_FIELD_3(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_2(Type, __VA_ARGS__))
+#define JPP_FIELD_4(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_3(Type, __VA_ARGS__))
+#define JPP_FIELD_5(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_4(Type, __VA_ARGS__))
+#define JPP_FIELD_6(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_5(Type, __VA_ARGS__))
+#define JPP_FIELD_7(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_6(Type, __VA_ARGS__))
+#define JPP_FIELD_8(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_7(Type, __VA_ARGS__))
+#define JPP_FIELD_9(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_8(Type, __VA_ARGS__))
+#define JPP_FIELD_10(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_9(Type, __VA_ARGS__))
+#define JPP_FIELD_11(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_10(Type, __VA_ARGS__))
+#define JPP_FIELD_12(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_11(Type, __VA_ARGS__))
+#define JPP_FIELD_13(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_12(Type, __VA_ARGS__))
+#define JPP_FIELD_14(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_13(Type, __VA_ARGS__))
+#define JPP_FIELD_15(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_14(Type, __VA_ARGS__))
+#define JPP_FIELD_16(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_15(Type, __VA_ARGS__))
+#define JPP_FIELD_17(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_16(Type, __VA_ARGS__))
+#define JPP_FIELD_18(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_17(Type, __VA_ARGS__))
+#define JPP_FIELD_19(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_18(Type, __VA_ARGS__))
+#define JPP_FIELD_20(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_19(Type, __VA_ARGS__))
+#define JPP_FIELD_21(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_20(Type, __VA_ARGS__))
+#define JPP_FIELD_22(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_21(Type, __VA_ARGS__))
+#define JPP_FIELD_23(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_22(Type, __VA_ARGS__))
+#define JPP_FIELD_24(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_23(Type, __VA_ARGS__))
+#define JPP_FIELD_25(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_24(Type, __VA_ARGS__))
+#define JPP_FIELD_26(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_25(Type, __VA_ARGS__))
+#define JPP_FIELD_27(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_26(Type, __VA_ARGS__))
+#define JPP_FIELD_28(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_27(Type, __VA_ARGS__))
+#define JPP_FIELD_29(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_28(Type, __VA_ARGS__))
+#define JPP_FIELD_30(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_29(Type, __VA_ARGS__))
+#define JPP_FIELD_31(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_30(Type, __VA_ARGS__))
+#define JPP_FIELD_32(Type, field, ...) JPP_FIELD_1(Type, field), JPP_EXPAND(JPP_FIELD_31(Type, __VA_ARGS__))
+#define JPP_FIELD_SELECT(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, _25, _26, _27, _28, _29, _30, _31, _32, NAME, ...) NAME
+#define JPP_FIELD_LIST(Type, ...) JPP_EXPAND(JPP_FIELD_SELECT(__VA_ARGS__, JPP_FIELD_32, JPP_FIELD_31, JPP_FIELD_30, JPP_FIELD_29, JPP_FIELD_28, JPP_FIELD_27, JPP_FIELD_26, JPP_FIELD_25, JPP_FIELD_24, JPP_FIELD_23, JPP_FIELD_22, JPP_FIELD_21, JPP_FIELD_20, JPP_FIELD_19, JPP_FIELD_18, JPP_FIELD_17, JPP_FIELD_16, JPP_FIELD_15, JPP_FIELD_14, JPP_FIELD_13, JPP_FIELD_12, JPP_FIELD_11, JPP_FIELD_10, JPP_FIELD_9, JPP_FIELD_8, JPP_FIELD_7, JPP_FIELD_6, JPP_FIELD_5, JPP_FIELD_4, JPP_FIELD_3, JPP_FIELD_2, JPP_FIELD_1)(Type, __VA_ARGS__))
+
+/**
+ * @brief Bind the listed members of a struct to the properties of a JSON object with the same names,
+ * for Jpp::Binder. Use it outside of any namespace, with up to 32 members
+ * @example
+ *  struct Person
+ *  {
+ *      std::string name;
+ *      int age;
+ *      std::vector<std::string> friends;
+ *  };
+ *  JPP_FIELDS(Person, name, age, friends)
+ * @since v1.5
+ */
+#define JPP_FIELDS(Type, ...)                                                                 \
+    template <>                                                                               \
+    struct Jpp::Fields<Type>                                                                  \
+    {                                                                                         \
+        static constexpr auto fields = std::make_tuple(JPP_FIELD_LIST(Type, __VA_ARGS__));   \
+    };
+
+// the instrumentation of Jpp::Stats is compiled only when JPP_STATS is defined before including jpp.hh
+#ifdef JPP_STATS
+#define JPP_STATS_ADD(field, amount) Jpp::Stats::add(&Jpp::Stats::field, (amount))
+#define JPP_STATS_TIMER(field) Jpp::Stats::Timer jpp_stats_timer(&Jpp::Stats::field)
+#define JPP_STATS_DEPTH(depth) Jpp::Stats::Depth jpp_stats_depth(depth)
+#define JPP_STATS_ALLOCATIONS(resource) Jpp::Stats::Allocations jpp_stats_allocations(resource)
+#else
+#define JPP_STATS_ADD(field, amount) ((void)0)
+#define JPP_STATS_TIMER(field) ((void)0)
+#define JPP_STATS_DEPTH(depth) ((void)0)
+#define JPP_STATS_ALLOCATIONS(resource) ((void)0)
+#endif
+
 namespace Jpp
 {
     enum JsonType
@@ -47,980 +166,6980 @@ namespace Jpp
     };
 
     /**
-     * @brief The Json class allows to parse a json string
-     *
+     * @brief A memory resource that forwards to an upstream resource and counts the allocations
+     * @since v1.5
      */
-    class Json
+    class CountingResource : public std::pmr::memory_resource
     {
     private:
-        JsonType type;
-        std::map<std::string, Json> children;
-        std::any value;
+        std::pmr::memory_resource *upstream;
+        size_t allocation_count;
+        size_t allocated_bytes;
 
-        std::map<std::string, Json> parse_object(std::string_view str, size_t &index)
+        void *do_allocate(size_t bytes, size_t alignment) override
         {
-            std::map<std::string, Jpp::Json> object;
-            Jpp::Token next;
-            std::string current_property;
-            Jpp::Json current_value;
-
-            ++index;
-            skip_white_spaces(str, index);
-
-            while (true)
-            {
-                next = match_next(str, index);
-
-                switch (next)
-                {
-                case Jpp::Token::END:
-                    throw std::invalid_argument("Unexpected the end of the string, expected a '}' at position: " + std::to_string(index));
-                case Jpp::Token::ARRAY_START:
-                    throw std::runtime_error("Unexpected the start of an array, expected a property name at position: " + std::to_string(index));
-                case Jpp::Token::ARRAY_END:
-                    throw std::runtime_error("Unexpected the end of an array, expected a property name at position: " + std::to_string(index));
-                case Jpp::Token::ALPHA:
-                    throw std::runtime_error("Unexpected a boolean value, expected a property name at position: " + std::to_string(index));
-                case Jpp::Token::NUMBER:
-                    throw std::runtime_error("Unexpected a number value, expected a property name at position: " + std::to_string(index));
-                case Jpp::Token::OBJECT_START:
-                    throw std::runtime_error("Unexpected the start of an object, expected a property name at position: " + std::to_string(index));
-                case Jpp::Token::OBJECT_END:
-                    return object;
-                case Jpp::Token::SEPARATOR:
-                    throw std::runtime_error("Unexpected separator, expected a property name at position: " + std::to_string(index));
-                case Jpp::Token::STRING:
-                    current_property = parse_string(str, index, str[index]);
-                    break;
-                }
-
-                skip_white_spaces(str, index);
-
-                if (str[index] != ':')
-                    throw std::runtime_error("Expected ':' at position: " + std::to_string(index));
-
-                ++index;
-
-                skip_white_spaces(str, index);
-
-                next = match_next(str, index);
-
-                switch (next)
-                {
-                case Jpp::Token::END:
-                    throw std::runtime_error("Unexpected the end of the string, a value is expected at position: " + std::to_string(index));
-                case Jpp::Token::ARRAY_START:
-                    current_value = get_unresolved_object(str, index, false);
-                    break;
-                case Jpp::Token::ARRAY_END:
-                    throw std::runtime_error("Unexpected the end of an array, a value is expected at position: " + std::to_string(index));
-                case Jpp::Token::OBJECT_START:
-                    current_value = get_unresolved_object(str, index, true);
-                    break;
-                case Jpp::Token::OBJECT_END:
-                    throw std::runtime_error("Unexpected the end of the object, a value is expected at position: " + std::to_string(index));
-                case Jpp::Token::ALPHA:
-                    if (str[index] == 'n')
-                        current_value = Jpp::Json(parse_null(str, index), Jpp::JSON_NULL);
-                    else
-                        current_value = Jpp::Json(parse_boolean(str, index), Jpp::JSON_BOOLEAN);
-                    break;
-                case Jpp::Token::NUMBER:
-                    current_value = Jpp::Json(parse_number(str, index), Jpp::JSON_NUMBER);
-                    break;
-                case Jpp::Token::STRING:
-                    current_value = Jpp::Json(parse_string(str, index, str[index]), Jpp::JSON_STRING);
-                    break;
-                case Jpp::Token::SEPARATOR:
-                    throw std::runtime_error("Unexpected separator, a value is expected at position: " + std::to_string(index));
-                }
-
-                skip_white_spaces(str, index);
-
-                next = match_next(str, index);
-                if (next != Jpp::Token::SEPARATOR && next != Jpp::Token::OBJECT_END)
-                    throw std::runtime_error("Expected a ',' or the end of the object at position: " + std::to_string(index));
-
-                ++index;
-
-                skip_white_spaces(str, index);
-
-                object.insert(std::pair<std::string, Jpp::Json>(current_property, current_value));
-
-                if (next == Jpp::Token::OBJECT_END)
-                    return object;
-            }
+            void *ptr = upstream->allocate(bytes, alignment);
+            ++allocation_count;
+            allocated_bytes += bytes;
+            return ptr;
         }
 
-        std::map<std::string, Json> parse_array(std::string_view str, size_t &index)
+        void do_deallocate(void *ptr, size_t bytes, size_t alignment) override
         {
-            std::map<std::string, Jpp::Json> object;
-            Jpp::Token next;
-            size_t current_index = 0;
-            Jpp::Json current_value;
+            upstream->deallocate(ptr, bytes, alignment);
+        }
 
-            ++index;
-            skip_white_spaces(str, index);
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
 
-            while (true)
-            {
-                next = match_next(str, index);
+    public:
+        /**
+         * @brief Construct a new CountingResource object
+         *
+         * @param upstream
+         * @since v1.5
+         */
+        inline CountingResource(std::pmr::memory_resource *upstream = std::pmr::get_default_resource()) noexcept
+        {
+            this->upstream = upstream;
+            this->allocation_count = 0;
+            this->allocated_bytes = 0;
+        }
 
-                switch (next)
-                {
-                case Jpp::Token::END:
-                    throw std::runtime_error("Unexpected the end of the string, the end of the array is expected at position: " + std::to_string(index));
-                case Jpp::Token::ARRAY_START:
-                    current_value = Jpp::Json(parse_array(str, index), Jpp::JSON_ARRAY);
-                    break;
-                case Jpp::Token::ARRAY_END:
-                    return object;
-                case Jpp::Token::OBJECT_START:
-                    current_value = Jpp::Json(parse_object(str, index), Jpp::JSON_OBJECT);
-                    break;
-                case Jpp::Token::OBJECT_END:
-                    throw std::runtime_error("Unexpected '}' token, a value is expected at position: " + std::to_string(index));
-                case Jpp::Token::ALPHA:
-                    if (str[index] == 'n')
-                        current_value = Jpp::Json(parse_null(str, index), Jpp::JSON_NULL);
-                    else
-                        current_value = Jpp::Json(parse_boolean(str, index), Jpp::JSON_BOOLEAN);
-                    break;
-                case Jpp::Token::NUMBER:
-                    current_value = Jpp::Json(parse_number(str, index), Jpp::JSON_NUMBER);
-                    break;
-                case Jpp::Token::STRING:
-                    current_value = Jpp::Json(parse_string(str, index, str[index]), Jpp::JSON_STRING);
-                    break;
-                case Jpp::Token::SEPARATOR:
-                    throw std::runtime_error("Unexpected separator, a value is expected at position: " + std::to_string(index));
-                }
+        /**
+         * @brief Get the number of allocations forwarded to the upstream resource
+         *
+         * @return size_t
+         * @since v1.5
+         */
+        inline size_t get_allocation_count() const noexcept
+        {
+            return this->allocation_count;
+        }
 
-                skip_white_spaces(str, index);
+        /**
+         * @brief Get the number of bytes requested to the upstream resource
+         *
+         * @return size_t
+         * @since v1.5
+         */
+        inline size_t get_allocated_bytes() const noexcept
+        {
+            return this->allocated_bytes;
+        }
 
-                next = match_next(str, index);
-                if (next != Jpp::Token::SEPARATOR && next != Jpp::Token::ARRAY_END)
-                    throw std::runtime_error("Expected a ',' or the end of the array at position: " + std::to_string(index));
+        /**
+         * @brief Reset the allocation counters
+         * @since v1.5
+         */
+        inline void reset_counters() noexcept
+        {
+            this->allocation_count = 0;
+            this->allocated_bytes = 0;
+        }
+    };
 
-                ++index;
+    /**
+     * @brief A memory resource that keeps the blocks given back to it and hands them out again, so that an arena
+     * released and refilled with a similar content stops requesting memory from the upstream resource.
+     * A request is served by the smallest free block that fits. Free blocks go back upstream on release or on destruction
+     * @since v1.5
+     */
+    class RecyclingResource : public std::pmr::memory_resource
+    {
+    private:
+        struct Block
+        {
+            void *ptr;
+            size_t bytes;
+            size_t alignment;
+            bool in_use;
+        };
 
-                skip_white_spaces(str, index);
+        std::pmr::memory_resource *upstream;
+        std::vector<Block> blocks;
 
-                object.insert(std::pair<std::string, Jpp::Json>(std::to_string(current_index), current_value));
-                ++current_index;
+        void *do_allocate(size_t bytes, size_t alignment) override
+        {
+            Block *best = nullptr;
 
-                if (next == Jpp::Token::ARRAY_END)
-                    return object;
+            for (Block &block : this->blocks)
+            {
+                if (!block.in_use && block.bytes >= bytes && block.alignment >= alignment && (best == nullptr || block.bytes < best->bytes))
+                    best = &block;
+            }
+            if (best != nullptr)
+            {
+                best->in_use = true;
+                return best->ptr;
             }
+            this->blocks.reserve(this->blocks.size() + 1);
+            void *ptr = this->upstream->allocate(bytes, alignment);
+            this->blocks.push_back(Block{ptr, bytes, alignment, true});
+            return ptr;
         }
 
-        std::string parse_string(std::string_view str, size_t &index, char start_with)
+        void do_deallocate(void *ptr, size_t, size_t) override
         {
-            std::string value;
-            bool escape = false;
-
-            ++index;
-            while (true)
+            for (Block &block : this->blocks)
             {
-                if (index >= str.length())
-                    throw std::runtime_error("Expected the end of the string");
-                if (str[index] == '\n')
-                    throw std::runtime_error("Unexpected end of the line while parsing the string: '" + value + "' at position: " + std::to_string(index));
-                if (str[index] == '\\' && !escape)
-                {
-                    escape = true;
-                    ++index;
-                    continue;
-                }
-
-                if (str[index] == start_with && !escape)
-                {
-                    ++index;
-                    return value;
-                }
-
-                if (escape)
+                if (block.ptr == ptr)
                 {
-                    escape = false;
-                    switch (str[index])
-                    {
-                    case 'n':
-                        value += '\n';
-                        ++index;
-                        continue;
-                    case 't':
-                        value += '\t';
-                        ++index;
-                        continue;
-                    case 'r':
-                        value += '\r';
-                        ++index;
-                        continue;
-                    case 'v':
-                        value += '\v';
-                        ++index;
-                        continue;
-                    case 'b':
-                        value += '\b';
-                        ++index;
-                        continue;
-                    }
+                    block.in_use = false;
+                    return;
                 }
-                value += str[index];
-                ++index;
-                escape = false;
             }
         }
 
-        std::any parse_number(std::string_view str, size_t &index)
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
         {
-            size_t start = index;
-            next_white_space_or_separator(str, index);
-            size_t end = index;
-            std::string_view substr = str.substr(start, end - start);
-
-            return std::stod(substr.data());
+            return this == &other;
         }
 
-        std::any parse_boolean(std::string_view str, size_t &index)
+    public:
+        /**
+         * @brief Construct a new RecyclingResource object
+         *
+         * @param upstream
+         * @since v1.5
+         */
+        inline RecyclingResource(std::pmr::memory_resource *upstream = std::pmr::get_default_resource()) noexcept
         {
-            size_t start = index;
-            next_white_space_or_separator(str, index);
-            size_t end = index;
-            std::string_view substr = str.substr(start, end - start);
-
-            if (substr == "true")
-                return true;
-            if (substr == "false")
-                return false;
-            throw std::runtime_error("Unrecognized token: " + std::string(substr.data()) + " at position: " + std::to_string(index));
+            this->upstream = upstream;
         }
 
-        std::any parse_null(std::string_view str, size_t &index)
-        {
-            size_t start = index;
-            next_white_space_or_separator(str, index);
-            size_t end = index;
-            std::string_view substr = str.substr(start, end - start);
-
-            if (substr == "null")
-                return nullptr;
+        RecyclingResource(const RecyclingResource &) = delete;
+        RecyclingResource &operator=(const RecyclingResource &) = delete;
 
-            throw std::runtime_error("Unrecognized token: " + std::string(substr.data()) + " at position: " + std::to_string(index));
+        inline ~RecyclingResource()
+        {
+            for (Block &block : this->blocks)
+                this->upstream->deallocate(block.ptr, block.bytes, block.alignment);
         }
 
-        bool is_resolved;
-        std::string unresolved_string;
+        /**
+         * @brief Give the free blocks back to the upstream resource
+         * @since v1.5
+         */
+        inline void release() noexcept
+        {
+            std::erase_if(this->blocks, [this](const Block &block)
+                          {
+                if (block.in_use)
+                    return false;
+                this->upstream->deallocate(block.ptr, block.bytes, block.alignment);
+                return true; });
+        }
 
-        Token match_next(std::string_view str, size_t &index)
+        /**
+         * @brief Get the number of bytes kept in blocks, in use or free
+         *
+         * @return size_t
+         * @since v1.5
+         */
+        inline size_t get_kept_bytes() const noexcept
         {
-            if (index >= str.length())
-                return Jpp::Token::END;
-            switch (str[index])
-            {
-            case '{':
-                return Jpp::Token::OBJECT_START;
-            case '}':
-                return Jpp::Token::OBJECT_END;
-            case ',':
-                return Jpp::Token::SEPARATOR;
-            case '"':
-            case '\'':
-                return Jpp::Token::STRING;
-            case '[':
-                return Jpp::Token::ARRAY_START;
-            case ']':
-                return Jpp::Token::ARRAY_END;
-            }
-            if (str[index] >= '0' && str[index] <= '9')
-                return Jpp::Token::NUMBER;
-            if (isalpha(str[index]))
-                return Jpp::Token::ALPHA;
-            throw std::runtime_error("Unexpected " + std::string(1, str[index]) + " token at position: " + std::to_string(index));
+            size_t bytes = 0;
+            for (const Block &block : this->blocks)
+                bytes += block.bytes;
+            return bytes;
         }
+    };
+
+    /**
+     * @brief Statistics of the parser and the serializer, collected on the current thread while a StatsScope is active.
+     * They are only collected when JPP_STATS is defined before including jpp.hh, otherwise the hooks compile to nothing.
+     * The phases can overlap: a lazy subtree materialized while serializing counts in both times.
+     * Allocations are counted when parsing into a CountingResource or a Document
+     * @since v1.5
+     */
+    struct Stats
+    {
+        size_t bytes_parsed = 0;
+        size_t bytes_written = 0;
+        size_t objects = 0;
+        size_t arrays = 0;
+        size_t strings = 0;
+        size_t numbers = 0;
+        size_t booleans = 0;
+        size_t nulls = 0;
+        size_t max_depth = 0;
+        size_t string_bytes_copied = 0;
+        size_t lazy_materializations = 0;
+        size_t allocations = 0;
+        size_t allocated_bytes = 0;
+        uint64_t parse_ns = 0;
+        uint64_t materialize_ns = 0;
+        uint64_t serialize_ns = 0;
 
-        inline bool is_space(char ch) noexcept
+        /**
+         * @brief Add the statistics of another collection, keeping the larger depth
+         *
+         * @param other
+         * @return Stats&
+         * @since v1.5
+         */
+        Stats &operator+=(const Stats &other) noexcept
         {
-            return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\v';
+            this->bytes_parsed += other.bytes_parsed;
+            this->bytes_written += other.bytes_written;
+            this->objects += other.objects;
+            this->arrays += other.arrays;
+            this->strings += other.strings;
+            this->numbers += other.numbers;
+            this->booleans += other.booleans;
+            this->nulls += other.nulls;
+            this->max_depth = std::max(this->max_depth, other.max_depth);
+            this->string_bytes_copied += other.string_bytes_copied;
+            this->lazy_materializations += other.lazy_materializations;
+            this->allocations += other.allocations;
+            this->allocated_bytes += other.allocated_bytes;
+            this->parse_ns += other.parse_ns;
+            this->materialize_ns += other.materialize_ns;
+            this->serialize_ns += other.serialize_ns;
+            return *this;
         }
 
-        inline void next_white_space_or_separator(std::string_view str, size_t &index) noexcept
+        /**
+         * @brief Get the collection of the current thread
+         *
+         * @return Stats*& nullptr when no StatsScope is active
+         * @since v1.5
+         */
+        static inline Stats *&current() noexcept
         {
-            while (index < str.length() && !is_space(str[index]) && str[index] != '[' && str[index] != '{' && str[index] != ',' && str[index] != ']' && str[index] != '}')
-                ++index;
+            thread_local Stats *stats = nullptr;
+            return stats;
         }
 
-        inline void skip_white_spaces(std::string_view str, size_t &index) noexcept
+        static inline void add(size_t Stats::*field, size_t amount) noexcept
         {
-            while (index < str.length() && is_space(str[index]))
-                ++index;
+            if (Stats *stats = current())
+                stats->*field += amount;
         }
 
-        inline std::string json_object_to_string(const Json &json)
+        /**
+         * @brief Add the time of its scope to a phase
+         */
+        class Timer
         {
-            std::map<std::string, Jpp::Json> children = json.children;
-            if (children.size() == 0)
-                return "{}";
-            if (!is_resolved)
-                return unresolved_string;
-            std::map<std::string, Jpp::Json>::iterator it;
-            std::string str = "{";
+        private:
+            uint64_t Stats::*field;
+            Stats *stats;
+            std::chrono::steady_clock::time_point start;
 
-            for (it = children.begin(); it != std::prev(children.end()); ++it)
+        public:
+            inline explicit Timer(uint64_t Stats::*field) noexcept : field(field), stats(current())
             {
-                str += "\"" + it->first + "\":";
-                str += it->second.to_string();
-                str += ", ";
+                if (this->stats != nullptr)
+                    this->start = std::chrono::steady_clock::now();
             }
 
-            str += "\"" + std::prev(children.end())->first + "\":";
-            str += std::prev(children.end())->second.to_string();
+            Timer(const Timer &) = delete;
+            Timer &operator=(const Timer &) = delete;
 
-            return str + "}";
-        }
+            inline ~Timer()
+            {
+                if (this->stats != nullptr)
+                    this->stats->*field += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->start).count());
+            }
+        };
 
-        inline std::string json_array_to_string(const Json &json)
+        /**
+         * @brief Count a level of nesting for its scope
+         */
+        class Depth
         {
-            std::map<std::string, Jpp::Json> children = json.children;
-            if (children.size() == 0)
-                return "[]";
-            if (!is_resolved)
-                return unresolved_string;
-            std::map<std::string, Jpp::Json>::iterator it;
-            std::string str = "[";
+        private:
+            size_t &depth;
 
-            for (it = children.begin(); it != std::prev(children.end()); ++it)
+        public:
+            inline explicit Depth(size_t &depth) noexcept : depth(depth)
             {
-                str += it->second.to_string();
-                str += ",";
+                if (Stats *stats = current())
+                    stats->max_depth = std::max(stats->max_depth, ++this->depth);
             }
 
-            str += std::prev(children.end())->second.to_string();
-
-            return str + "]";
-        }
+            Depth(const Depth &) = delete;
+            Depth &operator=(const Depth &) = delete;
 
-        inline std::string str_replace(std::string_view original, char old, std::string_view new_str)
-        {
-            std::string str = "";
-            for (char ch : original)
+            inline ~Depth()
             {
-                if (ch == old)
-                    str += new_str;
-                else
-                    str += ch;
+                if (current() != nullptr)
+                    --this->depth;
             }
-            return str;
-        }
+        };
 
-        Json get_unresolved_object(std::string_view str, size_t &index, bool is_object)
+        /**
+         * @brief Add the allocations made by a CountingResource during its scope
+         */
+        class Allocations
         {
-            const char end = is_object ? '}' : ']';
-            const char start = is_object ? '{' : '[';
-            char is_string = false;
-            bool escape = false;
-            std::string unresolved;
-            Jpp::Json unresolved_json;
-            int level = 0;
-            bool cycle = true;
+        private:
+            const CountingResource *resource;
+            size_t count = 0;
+            size_t bytes = 0;
 
-            while (cycle)
+        public:
+            inline explicit Allocations(const std::pmr::memory_resource *resource) noexcept
+                : resource(current() != nullptr ? dynamic_cast<const CountingResource *>(resource) : nullptr)
             {
-                if (!(is_space(str[index]) && !is_string))
-                    unresolved += str[index];
-                index++;
-                if (index >= str.length())
-                    throw std::runtime_error("Unexpected end of the string");
-
-                switch (str[index])
+                if (this->resource != nullptr)
                 {
-                case '"':
-                    if (escape || is_string == '\'')
-                    {
-                        escape = false;
-                        break;
-                    }
-                    if (is_string == '"')
-                    {
-                        escape = false;
-                        is_string = false;
-                        break;
-                    }
-                    escape = false;
-                    is_string = '"';
-                    break;
-                case '\'':
-                    if (escape || is_string == '"')
-                    {
-                        escape = false;
-                        break;
-                    }
-                    if (is_string == '\'')
+                    this->count = this->resource->get_allocation_count();
+                    this->bytes = this->resource->get_allocated_bytes();
+                }
+            }
+
+            Allocations(const Allocations &) = delete;
+            Allocations &operator=(const Allocations &) = delete;
+
+            inline ~Allocations()
+            {
+                if (this->resource == nullptr)
+                    return;
+                add(&Stats::allocations, this->resource->get_allocation_count() - this->count);
+                add(&Stats::allocated_bytes, this->resource->get_allocated_bytes() - this->bytes);
+            }
+        };
+    };
+
+    /**
+     * @brief Collect the statistics of the current thread during its lifetime, into a Stats or for a callback
+     * called with them when the scope ends. Scopes can be nested, the inner one collects until it ends
+     * @example
+     *  Jpp::Stats stats;
+     *  {
+     *      Jpp::StatsScope scope(stats);
+     *      json.parse(payload);
+     *  }
+     *  metrics.record("json.bytes", stats.bytes_parsed);
+     * @since v1.5
+     */
+    class StatsScope
+    {
+    private:
+        Stats collected;
+        Stats *stats;
+        Stats *previous;
+        std::function<void(const Stats &)> callback;
+
+    public:
+        /**
+         * @brief Add the statistics of the scope to the given ones
+         *
+         * @param stats
+         * @since v1.5
+         */
+        inline explicit StatsScope(Stats &stats) noexcept : stats(&stats), previous(Stats::current())
+        {
+            Stats::current() = this->stats;
+        }
+
+        /**
+         * @brief Call the callback with the statistics of the scope when it ends
+         *
+         * @param callback
+         * @since v1.5
+         */
+        inline explicit StatsScope(std::function<void(const Stats &)> callback) noexcept
+            : stats(&collected), previous(Stats::current()), callback(std::move(callback))
+        {
+            Stats::current() = this->stats;
+        }
+
+        StatsScope(const StatsScope &) = delete;
+        StatsScope &operator=(const StatsScope &) = delete;
+
+        inline ~StatsScope()
+        {
+            Stats::current() = this->previous;
+            if (this->callback)
+                this->callback(*this->stats);
+        }
+    };
+
+    /**
+     * @brief The instruction sets the scanner can use to classify the characters
+     * @since v1.5
+     */
+    enum SimdLevel
+    {
+        SIMD_AUTO,
+        SIMD_SCALAR,
+        SIMD_SSE2,
+        SIMD_AVX2
+    };
+
+    /**
+     * @brief First stage of the parser: finds the structural characters of a JSON string.
+     * The string is classified 64 bytes at a time with the best instruction set of the CPU,
+     * and the scanner yields, in order, the positions of the brackets, colons and commas outside strings,
+     * the opening and closing quotes of the strings and the first character of the other values
+     * @since v1.5
+     */
+    class Scanner
+    {
+    private:
+        struct State
+        {
+            uint64_t escaped;
+            uint64_t scalar;
+            char quote;
+        };
+
+        struct Masks
+        {
+            uint64_t quote;
+            uint64_t single_quote;
+            uint64_t backslash;
+            uint64_t white_space;
+            uint64_t op;
+        };
+
+        using Finder = uint64_t (*)(const char *, State &) noexcept;
+
+        std::string_view str;
+        size_t offset;
+        size_t base;
+        uint64_t structurals;
+        State state;
+        Finder finder;
+
+        static uint64_t find_scalar(const char *block, State &state) noexcept
+        {
+            uint64_t structurals = 0;
+
+            for (int i = 0; i < 64; ++i)
+            {
+                const char ch = block[i];
+                const uint64_t bit = uint64_t(1) << i;
+                const bool escaped = state.escaped;
+
+                state.escaped = ch == '\\' && !escaped;
+                if (state.quote)
+                {
+                    if (ch == state.quote && !escaped)
                     {
-                        escape = false;
-                        is_string = false;
-                        break;
+                        state.quote = 0;
+                        structurals |= bit;
                     }
-                    escape = false;
-                    is_string = '\'';
-                    break;
-                case '\\':
-                    if (!is_string)
-                        throw std::runtime_error("Unexpected '\\' token at position: " + std::to_string(index));
-                    escape = !escape;
-                    break;
+                    continue;
+                }
+
+                if ((ch == '"' || ch == '\'') && !escaped)
+                {
+                    state.quote = ch;
+                    state.scalar = 0;
+                    structurals |= bit;
+                    continue;
+                }
+
+                switch (ch)
+                {
                 case '{':
-                case '[':
-                    if (str[index] != start)
-                        break;
-                    if (!is_string)
-                        level++;
-                    break;
                 case '}':
+                case '[':
                 case ']':
-                    if (str[index] != end)
-                        break;
-                    if (!is_string)
-                    {
-                        if (level == 0)
-                            cycle = false;
-                        else
-                            level--;
-                        break;
-                    }
+                case ':':
+                case ',':
+                    state.scalar = 0;
+                    structurals |= bit;
+                    break;
+                case ' ':
+                case '\t':
+                case '\n':
+                case '\r':
+                case '\v':
+                    state.scalar = 0;
                     break;
                 default:
-                    escape = false;
+                    if (!state.scalar)
+                        structurals |= bit;
+                    state.scalar = 1;
                     break;
                 }
             }
-            index++;
-            unresolved += end;
-            unresolved_json.type = is_object ? JSON_OBJECT : JSON_ARRAY;
-            unresolved_json.is_resolved = false;
-            unresolved_json.unresolved_string = unresolved;
-            return unresolved_json;
+            return structurals;
         }
 
-    public:
-        /**
-         * @brief Construct a new Json object
-         * @since v1.0
-         */
-        inline Json() noexcept
+        static inline uint64_t prefix_xor(uint64_t bits) noexcept
         {
-            this->type = JSON_OBJECT;
-            this->is_resolved = true;
+            bits ^= bits << 1;
+            bits ^= bits << 2;
+            bits ^= bits << 4;
+            bits ^= bits << 8;
+            bits ^= bits << 16;
+            bits ^= bits << 32;
+            return bits;
         }
 
         /**
-         * @brief Construct a new Json object
-         *
-         * @param children
-         * @param type
-         * @since v1.0
+         * @brief Turn the character classes of a block into its structurals. Blocks with single quoted strings
+         * are rare, and the quotes of the two kinds cannot be told apart with masks, so they are scanned byte by byte
          */
-        inline Json(std::map<std::string, Json> children, JsonType type) noexcept
+        static inline uint64_t find_structurals(const Masks &masks, const char *block, State &state) noexcept
         {
-            this->children = children;
-            this->type = type;
-            this->is_resolved = true;
+            if (masks.single_quote != 0 || state.quote == '\'')
+                return find_scalar(block, state);
+
+            // a run of backslashes escapes the character that follows it only if its length is odd
+            const uint64_t even_bits = 0x5555555555555555ULL;
+            uint64_t backslash = masks.backslash & ~state.escaped;
+            uint64_t follows_escape = (backslash << 1) | state.escaped;
+            uint64_t odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+            uint64_t sequences_starting_on_even_bits = odd_sequence_starts + backslash;
+            uint64_t escaped = (even_bits ^ (sequences_starting_on_even_bits << 1)) & follows_escape;
+
+            uint64_t quote = masks.quote & ~escaped;
+            uint64_t in_string = prefix_xor(quote) ^ (state.quote ? ~uint64_t(0) : 0);
+            uint64_t scalar = ~(masks.white_space | masks.op | quote | in_string);
+            uint64_t scalar_starts = scalar & ~((scalar << 1) | state.scalar);
+
+            state.quote = (in_string >> 63) ? '"' : 0;
+            state.escaped = sequences_starting_on_even_bits < odd_sequence_starts;
+            state.scalar = scalar >> 63;
+            return (masks.op & ~in_string) | quote | scalar_starts;
+        }
+
+#ifdef JPP_SIMD_X86
+        static inline uint64_t equal_sse2(__m128i chunk, char ch) noexcept
+        {
+            return static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(ch))));
+        }
+
+        static uint64_t find_sse2(const char *block, State &state) noexcept
+        {
+            Masks masks = {};
+
+            for (int i = 0; i < 4; ++i)
+            {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 16 * i));
+                const __m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+                const int shift = 16 * i;
+
+                masks.quote |= equal_sse2(chunk, '"') << shift;
+                masks.single_quote |= equal_sse2(chunk, '\'') << shift;
+                masks.backslash |= equal_sse2(chunk, '\\') << shift;
+                masks.white_space |= (equal_sse2(chunk, ' ') | equal_sse2(chunk, '\t') | equal_sse2(chunk, '\n') |
+                                      equal_sse2(chunk, '\r') | equal_sse2(chunk, '\v'))
+                                     << shift;
+                // '[' and ']' differ from '{' and '}' only by the 0x20 bit
+                masks.op |= (equal_sse2(lower, '{') | equal_sse2(lower, '}') | equal_sse2(chunk, ':') | equal_sse2(chunk, ','))
+                            << shift;
+            }
+            return find_structurals(masks, block, state);
+        }
+
+        JPP_TARGET_AVX2 static inline uint64_t equal_avx2(__m256i chunk, char ch) noexcept
+        {
+            return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(ch))));
+        }
+
+        JPP_TARGET_AVX2 static uint64_t find_avx2(const char *block, State &state) noexcept
+        {
+            Masks masks = {};
+
+            for (int i = 0; i < 2; ++i)
+            {
+                const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32 * i));
+                const __m256i lower = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+                const int shift = 32 * i;
+
+                masks.quote |= equal_avx2(chunk, '"') << shift;
+                masks.single_quote |= equal_avx2(chunk, '\'') << shift;
+                masks.backslash |= equal_avx2(chunk, '\\') << shift;
+                masks.white_space |= (equal_avx2(chunk, ' ') | equal_avx2(chunk, '\t') | equal_avx2(chunk, '\n') |
+                                      equal_avx2(chunk, '\r') | equal_avx2(chunk, '\v'))
+                                     << shift;
+                masks.op |= (equal_avx2(lower, '{') | equal_avx2(lower, '}') | equal_avx2(chunk, ':') | equal_avx2(chunk, ','))
+                            << shift;
+            }
+            return find_structurals(masks, block, state);
+        }
+
+        static bool has_avx2() noexcept
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] < 7)
+                return false;
+            __cpuid(info, 1);
+            if (!(info[2] & (1 << 27)) || (_xgetbv(0) & 6) != 6)
+                return false;
+            __cpuidex(info, 7, 0);
+            return info[1] & (1 << 5);
+#else
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+#endif
+
+        static Finder get_finder(SimdLevel level) noexcept
+        {
+            switch (level == SIMD_AUTO ? get_simd_level() : level)
+            {
+#ifdef JPP_SIMD_X86
+            case SIMD_AVX2:
+                return has_avx2() ? find_avx2 : find_sse2;
+            case SIMD_SSE2:
+                return find_sse2;
+#endif
+            default:
+                return find_scalar;
+            }
+        }
+
+        inline void next_block() noexcept
+        {
+            this->base = this->offset;
+            if (this->str.length() - this->offset >= 64)
+            {
+                this->structurals = this->finder(this->str.data() + this->offset, this->state);
+                this->offset += 64;
+                return;
+            }
+            char block[64];
+            std::fill(block, block + 64, ' ');
+            this->str.copy(block, 64, this->offset);
+            this->structurals = this->finder(block, this->state);
+            this->offset = this->str.length();
         }
 
+    public:
         /**
-         * @brief Construct a new Json object
+         * @brief Construct a new Scanner object
          *
-         * @param value
-         * @param type
-         * @since v1.0
+         * @param str
+         * @param level the instruction set to use, the best one supported by the CPU by default
+         * @since v1.5
          */
-        inline Json(std::any value, JsonType type) noexcept
+        inline Scanner(std::string_view str, SimdLevel level = SIMD_AUTO) noexcept
         {
-            this->value = value;
-            this->type = type;
-            this->is_resolved = true;
+            this->str = str;
+            this->offset = 0;
+            this->base = 0;
+            this->structurals = 0;
+            this->state = State{0, 0, 0};
+            this->finder = get_finder(level);
         }
 
         /**
-         * @brief Construct a new Json object
+         * @brief Get the position of the next structural character
          *
-         * @param values
-         * @since v1.4
+         * @return size_t the position, or the length of the string when there are no more structurals
+         * @since v1.5
          */
-        inline Json(std::vector<std::any> values)
+        inline size_t next() noexcept
         {
-            this->type = JSON_ARRAY;
-            this->is_resolved = true;
-            for (size_t i = 0; i < values.size(); ++i)
+            while (this->structurals == 0)
             {
-                this->children.emplace(std::to_string(i), Json(values[i]));
+                if (this->offset >= this->str.length())
+                    return this->str.length();
+                next_block();
             }
+            size_t position = this->base + std::countr_zero(this->structurals);
+            this->structurals &= this->structurals - 1;
+            return position;
         }
 
         /**
-         * @brief Construct a new Json object
+         * @brief Continue the scan from the given position, which must not be inside a string
          *
-         * @param key_values
-         * @since v1.4
+         * @param position
+         * @since v1.5
          */
-        inline Json(std::vector<std::pair<std::string, std::any>> key_values)
+        inline void seek(size_t position) noexcept
         {
-            this->type = JSON_OBJECT;
-            this->is_resolved = true;
-            for (size_t i = 0; i < key_values.size(); ++i)
-            {
-                this->children.emplace(key_values[i].first, Json(key_values[i].second));
-            }
+            this->offset = position;
+            this->base = position;
+            this->structurals = 0;
+            this->state = State{0, 0, 0};
         }
 
         /**
-         * @brief Construct a new Json object
+         * @brief Get the best instruction set supported by the CPU
          *
-         * @param value
-         * @since v1.4
+         * @return SimdLevel
+         * @since v1.5
          */
-        Json(std::any value)
+        static SimdLevel get_simd_level() noexcept
         {
-            this->is_resolved = true;
-            size_t hash = value.type().hash_code();
-            if (hash == typeid(int).hash_code())
-            {
-                this->value = static_cast<double>(std::any_cast<int>(value));
-                this->type = JSON_NUMBER;
-                return;
-            }
-            if (hash == typeid(const char *).hash_code())
-            {
-                this->value = std::string(std::any_cast<const char *>(value));
-                this->type = JSON_STRING;
-                return;
-            }
-            if (hash == typeid(std::string).hash_code())
-            {
-                this->value = value;
-                this->type = JSON_STRING;
-                return;
-            }
-            if (hash == typeid(bool).hash_code())
-            {
-                this->value = value;
-                this->type = JSON_BOOLEAN;
-                return;
-            }
-            if (hash == typeid(double).hash_code())
-            {
-                this->value = value;
-                this->type = JSON_NUMBER;
-                return;
-            }
-            if (hash == typeid(std::nullptr_t).hash_code())
+#ifdef JPP_SIMD_X86
+            static const SimdLevel level = has_avx2() ? SIMD_AVX2 : SIMD_SSE2;
+            return level;
+#else
+            return SIMD_SCALAR;
+#endif
+        }
+    };
+
+    /**
+     * @brief A buffered output for the serializer. The text is collected in a fixed buffer
+     * and handed to the sink, a string, a stream or a file descriptor, when the buffer is full
+     * @since v1.5
+     */
+    class Writer
+    {
+    private:
+        using Sink = void (*)(void *target, const char *data, size_t length);
+
+        static constexpr size_t buffer_size = 4096;
+
+        char buffer[buffer_size];
+        size_t length;
+        size_t written = 0;
+        void *target;
+        Sink sink;
+
+        static void write_string(void *target, const char *data, size_t length)
+        {
+            static_cast<std::string *>(target)->append(data, length);
+        }
+
+        static void write_pmr_string(void *target, const char *data, size_t length)
+        {
+            static_cast<std::pmr::string *>(target)->append(data, length);
+        }
+
+        static void write_stream(void *target, const char *data, size_t length)
+        {
+            static_cast<std::ostream *>(target)->write(data, static_cast<std::streamsize>(length));
+        }
+
+        static void write_descriptor(void *target, const char *data, size_t length)
+        {
+            int fd = static_cast<int>(reinterpret_cast<intptr_t>(target));
+            while (length > 0)
             {
-                this->value = value;
-                this->type = JSON_NULL;
-                return;
+#ifdef _WIN32
+                int written = _write(fd, data, static_cast<unsigned int>(length));
+#else
+                ssize_t written = ::write(fd, data, length);
+                if (written < 0 && errno == EINTR)
+                    continue;
+#endif
+                if (written <= 0)
+                    throw std::runtime_error("Unable to write to the file descriptor: " + std::to_string(fd));
+                data += written;
+                length -= static_cast<size_t>(written);
             }
-            throw std::runtime_error("Unknown type: " + std::string(value.type().name()));
         }
 
+    public:
         /**
-         * @brief Construct a new Json object
+         * @brief Construct a new Writer object that appends to a string
          *
-         * @param str
-         * @since v1.0
+         * @param out
+         * @since v1.5
          */
-        inline Json(std::string str) noexcept
+        inline Writer(std::string &out) noexcept
         {
-            this->value = str;
-            this->type = JSON_STRING;
-            this->is_resolved = true;
+            this->length = 0;
+            this->target = &out;
+            this->sink = write_string;
         }
 
         /**
-         * @brief Construct a new Json object
+         * @brief Construct a new Writer object that appends to a string allocated from a memory resource
          *
-         * @param num
-         * @since v1.0
+         * @param out
+         * @since v1.5
          */
-        inline Json(double num) noexcept
+        inline Writer(std::pmr::string &out) noexcept
         {
-            this->value = num;
-            this->type = JSON_NUMBER;
-            this->is_resolved = true;
+            this->length = 0;
+            this->target = &out;
+            this->sink = write_pmr_string;
         }
 
         /**
-         * @brief Construct a new Json object
+         * @brief Construct a new Writer object that writes to a stream
          *
-         * @param val
-         * @since v1.0
+         * @param out
+         * @since v1.5
          */
-        inline Json(bool val) noexcept
+        inline Writer(std::ostream &out) noexcept
         {
-            this->value = val;
-            this->type = JSON_BOOLEAN;
-            this->is_resolved = true;
+            this->length = 0;
+            this->target = &out;
+            this->sink = write_stream;
         }
 
         /**
-         * @brief Construct a new Json object
+         * @brief Construct a new Writer object that writes to a file descriptor
          *
-         * @param null
-         * @since v1.0
+         * @param fd
+         * @since v1.5
          */
-        inline Json(std::nullptr_t null) noexcept
+        inline Writer(int fd) noexcept
         {
-            this->value = null;
-            this->type = JSON_NULL;
-            this->is_resolved = true;
+            this->length = 0;
+            this->target = reinterpret_cast<void *>(static_cast<intptr_t>(fd));
+            this->sink = write_descriptor;
         }
 
-        ~Json() = default;
+        Writer(const Writer &) = delete;
+        Writer &operator=(const Writer &) = delete;
+
+        inline ~Writer()
+        {
+            try
+            {
+                flush();
+            }
+            catch (...)
+            {
+            }
+        }
 
         /**
-         * @brief Get the type object
+         * @brief Write a character
          *
-         * @return JsonType
-         * @since v1.0
+         * @param ch
+         * @since v1.5
          */
-        inline JsonType get_type() noexcept
+        inline void put(char ch)
         {
-            return this->type;
+            if (this->length == buffer_size)
+                flush();
+            this->buffer[this->length++] = ch;
         }
 
         /**
-         * @brief Get the value object
+         * @brief Write a string
          *
-         * @return std::any
-         * @since v1.0
+         * @param str
+         * @since v1.5
          */
-        inline std::any get_value() noexcept
+        inline void write(std::string_view str)
         {
-            return this->value;
+            if (str.length() > buffer_size - this->length)
+            {
+                flush();
+                if (str.length() >= buffer_size)
+                {
+                    this->sink(this->target, str.data(), str.length());
+                    this->written += str.length();
+                    return;
+                }
+            }
+            std::copy(str.begin(), str.end(), this->buffer + this->length);
+            this->length += str.length();
         }
 
         /**
-         * @brief Check if the JSON value is an array
-         *
-         * @return true
-         * @return false
-         * @since v1.0
+         * @brief Hand the buffered text to the sink
+         * @since v1.5
          */
-        inline bool is_array() noexcept
+        inline void flush()
         {
-            return this->type == JSON_ARRAY;
+            if (this->length == 0)
+                return;
+            size_t length = this->length;
+            this->length = 0;
+            this->sink(this->target, this->buffer, length);
+            this->written += length;
         }
 
         /**
-         * @brief Check if the JSON value is an object
+         * @brief Get the number of bytes written so far, including the buffered ones
+         *
+         * @return size_t
+         * @since v1.5
+         */
+        inline size_t get_written_bytes() const noexcept
+        {
+            return this->written + this->length;
+        }
+    };
+
+    /**
+     * @brief A file mapped read-only in memory. Where memory mapping is not available the file is read into a buffer
+     * @since v1.5
+     */
+    class MappedFile
+    {
+    private:
+        const char *data;
+        size_t length;
+#ifdef _WIN32
+        std::string buffer;
+#endif
+
+    public:
+        /**
+         * @brief Map a file, hinting the kernel that it will be read sequentially
+         *
+         * @param path
+         * @since v1.5
+         */
+        explicit MappedFile(const std::string &path)
+        {
+            this->data = "";
+            this->length = 0;
+#ifdef _WIN32
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+                throw std::runtime_error("Unable to open the file: " + path);
+            this->buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            this->data = this->buffer.data();
+            this->length = this->buffer.length();
+#else
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                throw std::runtime_error("Unable to open the file: " + path);
+            struct stat info;
+            if (::fstat(fd, &info) < 0)
+            {
+                ::close(fd);
+                throw std::runtime_error("Unable to read the size of the file: " + path);
+            }
+            if (info.st_size > 0)
+            {
+                void *mapping = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapping == MAP_FAILED)
+                {
+                    ::close(fd);
+                    throw std::runtime_error("Unable to map the file: " + path);
+                }
+                ::madvise(mapping, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+                this->data = static_cast<const char *>(mapping);
+                this->length = static_cast<size_t>(info.st_size);
+            }
+            ::close(fd);
+#endif
+        }
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        inline ~MappedFile()
+        {
+#ifndef _WIN32
+            if (this->length > 0)
+                ::munmap(const_cast<char *>(this->data), this->length);
+#endif
+        }
+
+        /**
+         * @brief Get the content of the file
+         *
+         * @return std::string_view
+         * @since v1.5
+         */
+        inline std::string_view get_content() const noexcept
+        {
+            return std::string_view(this->data, this->length);
+        }
+    };
+
+    class KeyPool;
+
+    /**
+     * @brief Options of the parser
+     * @since v1.5
+     */
+    struct ParseOptions
+    {
+        /**
+         * @brief Store strings and property names as views of the parsed string instead of copying them.
+         * Strings with escape sequences are decoded when they are read.
+         * The parsed string must outlive the parsed value and all of its copies
+         */
+        bool borrow_strings = false;
+
+        /**
+         * @brief The number of threads that parse the elements of a root array, 0 to use all the cores.
+         * The memory resource must be safe to use from several threads, as the default one is
+         */
+        unsigned threads = 1;
+
+        /**
+         * @brief The number of bytes of a root array that a thread parses at a time
+         */
+        size_t chunk_size = 1 << 20;
+
+        /**
+         * @brief Keep the properties of the parsed objects in the order of the source instead of sorting them by name
+         */
+        bool keep_order = false;
+
+        /**
+         * @brief Take the property names from this pool instead of copying them into every object.
+         * The pool must outlive the parsed value and all of its copies
+         */
+        KeyPool *keys = nullptr;
+    };
+
+    /**
+     * @brief The name of a property. It either owns its characters or borrows them from the parsed string.
+     * Short names are stored inline
+     * @since v1.5
+     */
+    class Key
+    {
+    private:
+        friend class KeyPool;
+
+        const char *data;
+        size_t length;
+        size_t hash;
+        std::pmr::memory_resource *resource;
+        char buffer[16];
+
+        inline Key() noexcept
+        {
+            this->data = nullptr;
+            this->length = 0;
+            this->hash = 0;
+            this->resource = nullptr;
+        }
+
+        inline void copy(std::string_view str, std::pmr::memory_resource *resource)
+        {
+            copy(str, resource, hash_of(str));
+        }
+
+        inline void copy(std::string_view str, std::pmr::memory_resource *resource, size_t hash)
+        {
+            this->length = str.length();
+            this->hash = hash;
+            this->resource = resource;
+            char *data = this->buffer;
+            if (str.length() > sizeof(this->buffer))
+                data = static_cast<char *>(resource->allocate(str.length(), alignof(char)));
+            str.copy(data, str.length());
+            this->data = data;
+        }
+
+        inline void take(Key &other) noexcept
+        {
+            this->data = other.data;
+            this->length = other.length;
+            this->hash = other.hash;
+            this->resource = other.resource;
+            if (other.data == other.buffer)
+            {
+                std::copy(other.buffer, other.buffer + other.length, this->buffer);
+                this->data = this->buffer;
+            }
+            other.data = nullptr;
+            other.length = 0;
+            other.resource = nullptr;
+        }
+
+        inline void release() noexcept
+        {
+            if (this->resource != nullptr && this->data != nullptr && this->data != this->buffer)
+                this->resource->deallocate(const_cast<char *>(this->data), this->length, alignof(char));
+        }
+
+    public:
+        using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+        /**
+         * @brief Construct a new Key object owning a copy of the given name
+         *
+         * @param name
+         * @param allocator
+         * @since v1.5
+         */
+        inline Key(std::string_view name, const allocator_type &allocator = allocator_type())
+        {
+            copy(name, allocator.resource());
+        }
+
+        inline Key(const Key &other) : Key(other, allocator_type())
+        {
+        }
+
+        inline Key(const Key &other, const allocator_type &allocator)
+        {
+            if (other.resource != nullptr)
+            {
+                copy(other, allocator.resource(), other.hash);
+                return;
+            }
+            this->data = other.data;
+            this->length = other.length;
+            this->hash = other.hash;
+            this->resource = nullptr;
+        }
+
+        inline Key(Key &&other) noexcept
+        {
+            take(other);
+        }
+
+        inline Key(Key &&other, const allocator_type &allocator)
+        {
+            if (other.resource == nullptr || other.resource->is_equal(*allocator.resource()))
+                take(other);
+            else
+                copy(other, allocator.resource(), other.hash);
+        }
+
+        Key &operator=(const Key &) = delete;
+
+        inline Key &operator=(Key &&other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                take(other);
+            }
+            return *this;
+        }
+
+        inline ~Key()
+        {
+            release();
+        }
+
+        /**
+         * @brief The hash of a property name, the same one that keys store
+         *
+         * @param name
+         * @return size_t
+         * @since v1.5
+         */
+        static inline size_t hash_of(std::string_view name) noexcept
+        {
+            return std::hash<std::string_view>()(name);
+        }
+
+        /**
+         * @brief Create a key that refers to the given characters without copying them
+         *
+         * @param name must outlive the key
+         * @return Key
+         * @since v1.5
+         */
+        static inline Key borrow(std::string_view name) noexcept
+        {
+            Key key;
+            key.data = name.data();
+            key.length = name.length();
+            key.hash = hash_of(name);
+            return key;
+        }
+
+        /**
+         * @brief Get the hash of the name, computed once when the key is created
+         *
+         * @return size_t
+         * @since v1.5
+         */
+        inline size_t get_hash() const noexcept
+        {
+            return this->hash;
+        }
+
+        /**
+         * @brief Check if the key refers to characters it does not own
          *
          * @return true
          * @return false
-         * @since v1.0
+         * @since v1.5
+         */
+        inline bool is_borrowed() const noexcept
+        {
+            return this->resource == nullptr;
+        }
+
+        inline operator std::string_view() const noexcept
+        {
+            return std::string_view(this->data, this->length);
+        }
+
+        friend inline bool operator==(const Key &key, std::string_view str) noexcept
+        {
+            return std::string_view(key) == str;
+        }
+
+        friend inline bool operator==(const Key &key, const Key &other) noexcept
+        {
+            if (key.data == other.data && key.length == other.length)
+                return true;
+            return key.hash == other.hash && std::string_view(key) == std::string_view(other);
+        }
+
+        friend inline std::strong_ordering operator<=>(const Key &key, std::string_view str) noexcept
+        {
+            return std::string_view(key) <=> str;
+        }
+
+        friend inline std::strong_ordering operator<=>(const Key &key, const Key &other) noexcept
+        {
+            return std::string_view(key) <=> std::string_view(other);
+        }
+    };
+
+    /**
+     * @brief A set of property names shared by many documents. The keys it returns borrow their characters
+     * from the pool, so documents with the same schema do not copy their property names again, and two keys
+     * of the same pool are compared by address. It is safe to use from several threads and must outlive its keys
+     * @example
+     *  Jpp::KeyPool keys;
+     *  json.parse(json_string, Jpp::ParseOptions{.keys = &keys});
+     * @since v1.5
+     */
+    class KeyPool
+    {
+    private:
+        struct Name
+        {
+            const char *data;
+            size_t length;
+            size_t hash;
+        };
+
+        mutable std::shared_mutex mutex;
+        std::pmr::monotonic_buffer_resource names;
+        std::pmr::vector<Name> slots;
+        size_t count = 0;
+
+        const Name *find(std::string_view name, size_t hash) const noexcept
+        {
+            size_t mask = this->slots.size() - 1;
+            for (size_t i = hash & mask; this->slots[i].data != nullptr; i = (i + 1) & mask)
+            {
+                if (this->slots[i].hash == hash && std::string_view(this->slots[i].data, this->slots[i].length) == name)
+                    return &this->slots[i];
+            }
+            return nullptr;
+        }
+
+        void insert(const Name &name) noexcept
+        {
+            size_t mask = this->slots.size() - 1;
+            size_t i = name.hash & mask;
+            while (this->slots[i].data != nullptr)
+                i = (i + 1) & mask;
+            this->slots[i] = name;
+        }
+
+        static inline Key to_key(const Name &name) noexcept
+        {
+            Key key;
+            key.data = name.data;
+            key.length = name.length;
+            key.hash = name.hash;
+            return key;
+        }
+
+    public:
+        /**
+         * @brief Construct a new empty pool
+         *
+         * @param resource the resource of the names and of the table
+         * @since v1.5
+         */
+        inline explicit KeyPool(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : names(resource), slots(64, Name{nullptr, 0, 0}, resource)
+        {
+        }
+
+        /**
+         * @brief Get the key of the given name, adding the name to the pool the first time it is seen
+         *
+         * @param name
+         * @return Key
+         * @since v1.5
+         */
+        Key intern(std::string_view name)
+        {
+            size_t hash = Key::hash_of(name);
+            {
+                std::shared_lock lock(this->mutex);
+                if (const Name *found = find(name, hash))
+                    return to_key(*found);
+            }
+
+            std::unique_lock lock(this->mutex);
+            if (const Name *found = find(name, hash))
+                return to_key(*found);
+            if ((this->count + 1) * 2 > this->slots.size())
+            {
+                std::pmr::vector<Name> old(this->slots.size() * 2, Name{nullptr, 0, 0}, this->slots.get_allocator());
+                old.swap(this->slots);
+                for (const Name &entry : old)
+                    if (entry.data != nullptr)
+                        insert(entry);
+            }
+            char *data = static_cast<char *>(this->names.allocate(std::max<size_t>(name.length(), 1), alignof(char)));
+            name.copy(data, name.length());
+            Name entry{data, name.length(), hash};
+            insert(entry);
+            ++this->count;
+            return to_key(entry);
+        }
+
+        /**
+         * @brief Get the number of names in the pool
+         *
+         * @return size_t
+         * @since v1.5
+         */
+        inline size_t size() const
+        {
+            std::shared_lock lock(this->mutex);
+            return this->count;
+        }
+    };
+
+    /**
+     * @brief Random access iterator over a container whose elements are reached by position rather than by address
+     * @since v1.5
+     */
+    template <typename Owner, typename T>
+    class PositionIterator
+    {
+    private:
+        template <typename, typename>
+        friend class PositionIterator;
+
+        Owner *owner = nullptr;
+        size_t position = 0;
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T *;
+        using reference = T &;
+
+        PositionIterator() noexcept = default;
+
+        inline PositionIterator(Owner *owner, size_t position) noexcept : owner(owner), position(position) {}
+
+        template <typename OtherOwner, typename OtherT>
+            requires(!std::is_same_v<OtherT, T> && std::is_convertible_v<OtherT *, T *>)
+        inline PositionIterator(const PositionIterator<OtherOwner, OtherT> &other) noexcept : owner(other.owner), position(other.position) {}
+
+        inline T &operator*() const noexcept
+        {
+            return this->owner->element(this->position);
+        }
+
+        inline T *operator->() const noexcept
+        {
+            return &this->owner->element(this->position);
+        }
+
+        inline T &operator[](difference_type offset) const noexcept
+        {
+            return this->owner->element(this->position + offset);
+        }
+
+        inline PositionIterator &operator++() noexcept
+        {
+            ++this->position;
+            return *this;
+        }
+
+        inline PositionIterator operator++(int) noexcept
+        {
+            PositionIterator it = *this;
+            ++this->position;
+            return it;
+        }
+
+        inline PositionIterator &operator--() noexcept
+        {
+            --this->position;
+            return *this;
+        }
+
+        inline PositionIterator operator--(int) noexcept
+        {
+            PositionIterator it = *this;
+            --this->position;
+            return it;
+        }
+
+        inline PositionIterator &operator+=(difference_type offset) noexcept
+        {
+            this->position += offset;
+            return *this;
+        }
+
+        inline PositionIterator &operator-=(difference_type offset) noexcept
+        {
+            this->position -= offset;
+            return *this;
+        }
+
+        inline friend PositionIterator operator+(PositionIterator it, difference_type offset) noexcept
+        {
+            return it += offset;
+        }
+
+        inline friend PositionIterator operator+(difference_type offset, PositionIterator it) noexcept
+        {
+            return it += offset;
+        }
+
+        inline friend PositionIterator operator-(PositionIterator it, difference_type offset) noexcept
+        {
+            return it -= offset;
+        }
+
+        inline friend difference_type operator-(const PositionIterator &left, const PositionIterator &right) noexcept
+        {
+            return static_cast<difference_type>(left.position) - static_cast<difference_type>(right.position);
+        }
+
+        inline bool operator==(const PositionIterator &other) const noexcept
+        {
+            return this->position == other.position;
+        }
+
+        inline auto operator<=>(const PositionIterator &other) const noexcept
+        {
+            return this->position <=> other.position;
+        }
+    };
+
+    /**
+     * @brief A vector whose elements never move. Elements are stored in blocks that double in size,
+     * so growing the vector keeps references to its elements valid. It holds up to 2^32 - 1 elements
+     * @since v1.5
+     */
+    template <typename T>
+    class StableVector
+    {
+    public:
+        using value_type = T;
+        using allocator_type = std::pmr::polymorphic_allocator<T>;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using iterator = PositionIterator<StableVector, T>;
+        using const_iterator = PositionIterator<const StableVector, const T>;
+
+    private:
+        template <typename, typename>
+        friend class PositionIterator;
+
+        /**
+         * @brief The smallest first block
+         */
+        static constexpr size_t first_capacity = 4;
+
+        T *first = nullptr;
+        T **rest = nullptr;
+        allocator_type allocator;
+        uint32_t length = 0;
+        uint8_t rest_count = 0;
+        uint8_t shift = 0;
+
+        /**
+         * @brief The capacity of the table of the blocks after the first one
+         */
+        static inline size_t table_capacity(size_t blocks) noexcept
+        {
+            return std::max<size_t>(4, std::bit_ceil(blocks));
+        }
+
+        inline size_t block_capacity(size_t block) const noexcept
+        {
+            return (size_t(1) << this->shift) << (block == 0 ? 0 : block - 1);
+        }
+
+        inline T &element(size_t position) const noexcept
+        {
+            size_t scaled = position >> this->shift;
+            if (scaled == 0)
+                return this->first[position];
+            size_t block = std::bit_width(scaled);
+            return this->rest[block - 1][position - this->block_capacity(block)];
+        }
+
+        void grow(size_t capacity)
+        {
+            if (capacity > std::numeric_limits<uint32_t>::max())
+                throw std::length_error("Too many elements for a StableVector: " + std::to_string(capacity));
+            if (this->first == nullptr)
+            {
+                size_t count = std::bit_ceil(std::max(capacity, first_capacity));
+                this->first = this->allocator.allocate(count);
+                this->shift = static_cast<uint8_t>(std::countr_zero(count));
+            }
+            std::pmr::memory_resource *resource = this->allocator.resource();
+            while (this->capacity() < capacity)
+            {
+                size_t blocks = this->rest_count;
+                if (this->rest == nullptr || blocks == table_capacity(blocks))
+                {
+                    T **table = static_cast<T **>(resource->allocate(table_capacity(blocks + 1) * sizeof(T *), alignof(T *)));
+                    if (this->rest != nullptr)
+                    {
+                        std::copy_n(this->rest, blocks, table);
+                        resource->deallocate(this->rest, table_capacity(blocks) * sizeof(T *), alignof(T *));
+                    }
+                    this->rest = table;
+                }
+                // every new block is as large as all the previous ones together
+                this->rest[blocks] = this->allocator.allocate(this->capacity());
+                ++this->rest_count;
+            }
+        }
+
+        void release() noexcept
+        {
+            clear();
+            if (this->first != nullptr)
+                this->allocator.deallocate(this->first, this->block_capacity(0));
+            for (size_t block = 1; block <= this->rest_count; ++block)
+                this->allocator.deallocate(this->rest[block - 1], this->block_capacity(block));
+            if (this->rest != nullptr)
+                this->allocator.resource()->deallocate(this->rest, table_capacity(this->rest_count) * sizeof(T *), alignof(T *));
+            this->first = nullptr;
+            this->rest = nullptr;
+            this->rest_count = 0;
+            this->shift = 0;
+        }
+
+        void steal(StableVector &other) noexcept
+        {
+            this->first = std::exchange(other.first, nullptr);
+            this->rest = std::exchange(other.rest, nullptr);
+            this->length = std::exchange(other.length, 0);
+            this->rest_count = std::exchange(other.rest_count, 0);
+            this->shift = std::exchange(other.shift, 0);
+        }
+
+    public:
+        StableVector() noexcept = default;
+
+        explicit StableVector(const allocator_type &allocator) noexcept : allocator(allocator) {}
+
+        template <typename InputIt>
+        StableVector(InputIt begin, InputIt end, const allocator_type &allocator = allocator_type()) : allocator(allocator)
+        {
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+                reserve(std::distance(begin, end));
+            for (; begin != end; ++begin)
+                emplace_back(*begin);
+        }
+
+        StableVector(const StableVector &other) : StableVector(other, allocator_type()) {}
+
+        StableVector(const StableVector &other, const allocator_type &allocator) : allocator(allocator)
+        {
+            reserve(other.length);
+            for (const T &element : other)
+                emplace_back(element);
+        }
+
+        StableVector(StableVector &&other) noexcept : allocator(other.allocator)
+        {
+            steal(other);
+        }
+
+        StableVector(StableVector &&other, const allocator_type &allocator) : allocator(allocator)
+        {
+            if (this->allocator == other.allocator)
+            {
+                steal(other);
+                return;
+            }
+            reserve(other.length);
+            for (T &element : other)
+                emplace_back(std::move(element));
+        }
+
+        ~StableVector()
+        {
+            release();
+        }
+
+        StableVector &operator=(const StableVector &other)
+        {
+            if (this == &other)
+                return *this;
+            clear();
+            reserve(other.length);
+            for (const T &element : other)
+                emplace_back(element);
+            return *this;
+        }
+
+        StableVector &operator=(StableVector &&other)
+        {
+            if (this == &other)
+                return *this;
+            if (this->allocator == other.allocator)
+            {
+                release();
+                steal(other);
+                return *this;
+            }
+            clear();
+            reserve(other.length);
+            for (T &element : other)
+                emplace_back(std::move(element));
+            return *this;
+        }
+
+        inline allocator_type get_allocator() const noexcept
+        {
+            return this->allocator;
+        }
+
+        inline size_t size() const noexcept
+        {
+            return this->length;
+        }
+
+        inline bool empty() const noexcept
+        {
+            return this->length == 0;
+        }
+
+        inline size_t capacity() const noexcept
+        {
+            return this->first == nullptr ? 0 : (size_t(1) << this->shift) << this->rest_count;
+        }
+
+        inline void reserve(size_t capacity)
+        {
+            if (capacity > this->capacity())
+                grow(capacity);
+        }
+
+        inline T &operator[](size_t position) noexcept
+        {
+            return element(position);
+        }
+
+        inline const T &operator[](size_t position) const noexcept
+        {
+            return element(position);
+        }
+
+        inline T &front() noexcept
+        {
+            return *this->first;
+        }
+
+        inline const T &front() const noexcept
+        {
+            return *this->first;
+        }
+
+        inline T &back() noexcept
+        {
+            return element(this->length - 1);
+        }
+
+        inline const T &back() const noexcept
+        {
+            return element(this->length - 1);
+        }
+
+        inline iterator begin() noexcept
+        {
+            return iterator(this, 0);
+        }
+
+        inline iterator end() noexcept
+        {
+            return iterator(this, this->length);
+        }
+
+        inline const_iterator begin() const noexcept
+        {
+            return const_iterator(this, 0);
+        }
+
+        inline const_iterator end() const noexcept
+        {
+            return const_iterator(this, this->length);
+        }
+
+        template <typename... Args>
+        T &emplace_back(Args &&...args)
+        {
+            if (this->length == this->capacity())
+                grow(this->length + 1);
+            T *slot = &element(this->length);
+            std::allocator_traits<allocator_type>::construct(this->allocator, slot, std::forward<Args>(args)...);
+            ++this->length;
+            return *slot;
+        }
+
+        inline void push_back(const T &value)
+        {
+            emplace_back(value);
+        }
+
+        inline void push_back(T &&value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        void pop_back() noexcept
+        {
+            std::allocator_traits<allocator_type>::destroy(this->allocator, &element(--this->length));
+        }
+
+        void resize(size_t size, const T &value)
+        {
+            while (this->length > size)
+                pop_back();
+            reserve(size);
+            while (this->length < size)
+                emplace_back(value);
+        }
+
+        void clear() noexcept
+        {
+            while (this->length > 0)
+                pop_back();
+        }
+    };
+
+    /**
+     * @brief The properties of a JSON object, sorted by name or in insertion order.
+     * Properties are found through the hashes stored in their keys: small objects are searched linearly,
+     * larger ones through an open addressing index. The properties are stored in a StableVector, so inserting
+     * a property never moves the others and references to their values stay valid
+     * @since v1.5
+     */
+    template <typename Value>
+    class BasicObject
+    {
+    public:
+        using value_type = std::pair<Key, Value>;
+        using allocator_type = std::pmr::polymorphic_allocator<value_type>;
+        using iterator = PositionIterator<BasicObject, value_type>;
+        using const_iterator = PositionIterator<const BasicObject, const value_type>;
+
+    private:
+        friend Value;
+        friend class Builder;
+        template <typename, typename>
+        friend class PositionIterator;
+
+        /**
+         * @brief The size up to which an object is searched without an index
+         */
+        static constexpr size_t linear_limit = 8;
+
+        StableVector<value_type> entries;
+        /**
+         * @brief The storage index of each position, null while the entries are stored in order.
+         * It is created when a property is inserted before the last one
+         */
+        uint32_t *order = nullptr;
+        uint32_t *slots = nullptr;
+        uint32_t order_capacity = 0;
+        uint32_t slot_count = 0;
+        bool keep_order = false;
+
+        inline std::pmr::memory_resource *get_resource() const noexcept
+        {
+            return this->entries.get_allocator().resource();
+        }
+
+        inline value_type &element(size_t position) noexcept
+        {
+            return this->entries[this->order == nullptr ? position : this->order[position]];
+        }
+
+        inline const value_type &element(size_t position) const noexcept
+        {
+            return this->entries[this->order == nullptr ? position : this->order[position]];
+        }
+
+        template <typename Name>
+        size_t position_of(const Name &name, size_t hash) const noexcept
+        {
+            if (this->slots == nullptr)
+            {
+                for (size_t i = 0; i < this->entries.size(); ++i)
+                {
+                    const Key &key = element(i).first;
+                    if (key.get_hash() == hash && key == name)
+                        return i;
+                }
+                return this->entries.size();
+            }
+            size_t mask = this->slot_count - 1;
+            for (size_t i = hash & mask; this->slots[i] != 0; i = (i + 1) & mask)
+            {
+                const Key &key = element(this->slots[i] - 1).first;
+                if (key.get_hash() == hash && key == name)
+                    return this->slots[i] - 1;
+            }
+            return this->entries.size();
+        }
+
+        void release_index() noexcept
+        {
+            if (this->slots != nullptr)
+                get_resource()->deallocate(this->slots, this->slot_count * sizeof(uint32_t), alignof(uint32_t));
+            this->slots = nullptr;
+            this->slot_count = 0;
+        }
+
+        void release_order() noexcept
+        {
+            if (this->order != nullptr)
+                get_resource()->deallocate(this->order, this->order_capacity * sizeof(uint32_t), alignof(uint32_t));
+            this->order = nullptr;
+            this->order_capacity = 0;
+        }
+
+        /**
+         * @brief Make room in the order for one more property, creating it from the storage order if needed.
+         * The order is prepared before the property is stored, so that recording its position cannot fail
+         */
+        void prepare_order()
+        {
+            size_t count = this->entries.size();
+            if (this->order != nullptr && count < this->order_capacity)
+                return;
+            size_t capacity = std::max(count + 1, this->entries.capacity());
+            uint32_t *order = static_cast<uint32_t *>(get_resource()->allocate(capacity * sizeof(uint32_t), alignof(uint32_t)));
+            if (this->order != nullptr)
+                std::copy_n(this->order, count, order);
+            else
+                std::iota(order, order + count, uint32_t(0));
+            release_order();
+            this->order = order;
+            this->order_capacity = static_cast<uint32_t>(capacity);
+        }
+
+        void index(size_t position) noexcept
+        {
+            size_t mask = this->slot_count - 1;
+            size_t i = element(position).first.get_hash() & mask;
+            while (this->slots[i] != 0)
+                i = (i + 1) & mask;
+            this->slots[i] = static_cast<uint32_t>(position + 1);
+        }
+
+        void rebuild_index()
+        {
+            if (this->entries.size() <= linear_limit)
+            {
+                release_index();
+                return;
+            }
+            size_t count = std::max<size_t>(16, std::bit_ceil(this->entries.size() * 2));
+            if (count != this->slot_count)
+            {
+                release_index();
+                this->slots = static_cast<uint32_t *>(get_resource()->allocate(count * sizeof(uint32_t), alignof(uint32_t)));
+                this->slot_count = static_cast<uint32_t>(count);
+            }
+            std::fill_n(this->slots, count, 0);
+            for (size_t i = 0; i < this->entries.size(); ++i)
+                index(i);
+        }
+
+        /**
+         * @brief Index the last property, growing the index when it is half full
+         */
+        void index_back()
+        {
+            if (this->slots != nullptr && this->entries.size() * 2 <= this->slot_count)
+                index(this->entries.size() - 1);
+            else if (this->entries.size() > linear_limit)
+                rebuild_index();
+        }
+
+        /**
+         * @brief Append a property unless its name is already used, without sorting the names.
+         * The parser appends all the properties of an object and sorts them once with sort_by_name
+         */
+        bool append_unique(Key &&key, Value &&value)
+        {
+            if (position_of(key, key.get_hash()) < this->entries.size())
+                return false;
+            if (this->order != nullptr)
+                prepare_order();
+            this->entries.emplace_back(std::move(key), std::move(value));
+            if (this->order != nullptr)
+                this->order[this->entries.size() - 1] = static_cast<uint32_t>(this->entries.size() - 1);
+            index_back();
+            return true;
+        }
+
+        /**
+         * @brief Sort the properties of an object under construction. The entries themselves are moved,
+         * so nothing may refer to them yet
+         */
+        void sort_by_name()
+        {
+            auto by_name = [](const value_type &a, const value_type &b)
+            { return std::string_view(a.first) < std::string_view(b.first); };
+            if (this->keep_order || std::is_sorted(begin(), end(), by_name))
+                return;
+            release_order();
+            std::sort(this->entries.begin(), this->entries.end(), by_name);
+            rebuild_index();
+        }
+
+        template <typename Name, typename... Args>
+        iterator insert(Name &&name, Args &&...args)
+        {
+            std::string_view new_name = name;
+            size_t count = this->entries.size();
+            bool at_end = this->keep_order || count == 0 || std::string_view(element(count - 1).first) < new_name;
+            size_t offset = count;
+            if (!at_end)
+                offset = std::lower_bound(begin(), end(), new_name, [](const value_type &entry, std::string_view name)
+                                          { return std::string_view(entry.first) < name; }) -
+                         begin();
+            if (!at_end || this->order != nullptr)
+                prepare_order();
+            // the new entry is stored after the others, which never move
+            this->entries.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<Name>(name)),
+                                       std::forward_as_tuple(std::forward<Args>(args)...));
+            if (this->order != nullptr)
+            {
+                std::copy_backward(this->order + offset, this->order + count, this->order + count + 1);
+                this->order[offset] = static_cast<uint32_t>(count);
+            }
+            if (at_end)
+                index_back();
+            else
+                rebuild_index();
+            return begin() + offset;
+        }
+
+    public:
+        /**
+         * @brief Construct a new empty object
+         *
+         * @param allocator
+         * @param keep_order keep the properties in insertion order instead of sorting them by name
+         * @since v1.5
+         */
+        inline BasicObject(const allocator_type &allocator = allocator_type(), bool keep_order = false) noexcept
+            : entries(allocator), keep_order(keep_order)
+        {
+        }
+
+        inline BasicObject(const BasicObject &other) : BasicObject(other, allocator_type())
+        {
+        }
+
+        inline BasicObject(const BasicObject &other, const allocator_type &allocator)
+            : entries(allocator), keep_order(other.keep_order)
+        {
+            // the copy is stored in order, whatever the order of the storage of the other object
+            this->entries.reserve(other.size());
+            for (const value_type &entry : other)
+                this->entries.emplace_back(entry);
+            rebuild_index();
+        }
+
+        inline BasicObject(BasicObject &&other) noexcept
+            : entries(std::move(other.entries)), order(other.order), slots(other.slots), order_capacity(other.order_capacity),
+              slot_count(other.slot_count), keep_order(other.keep_order)
+        {
+            other.order = nullptr;
+            other.order_capacity = 0;
+            other.slots = nullptr;
+            other.slot_count = 0;
+        }
+
+        inline BasicObject(BasicObject &&other, const allocator_type &allocator)
+            : entries(allocator), keep_order(other.keep_order)
+        {
+            if (get_resource()->is_equal(*other.get_resource()))
+            {
+                this->entries = std::move(other.entries);
+                std::swap(this->order, other.order);
+                std::swap(this->order_capacity, other.order_capacity);
+            }
+            else
+            {
+                this->entries.reserve(other.size());
+                for (value_type &entry : other)
+                    this->entries.emplace_back(std::move(entry));
+            }
+            rebuild_index();
+        }
+
+        BasicObject &operator=(const BasicObject &other)
+        {
+            if (this != &other)
+                *this = BasicObject(other, get_allocator());
+            return *this;
+        }
+
+        BasicObject &operator=(BasicObject &&other)
+        {
+            if (this == &other)
+                return *this;
+            if (!get_resource()->is_equal(*other.get_resource()))
+                return *this = BasicObject(std::move(other), get_allocator());
+            this->entries = std::move(other.entries);
+            this->keep_order = other.keep_order;
+            release_order();
+            std::swap(this->order, other.order);
+            std::swap(this->order_capacity, other.order_capacity);
+            release_index();
+            std::swap(this->slots, other.slots);
+            std::swap(this->slot_count, other.slot_count);
+            return *this;
+        }
+
+        inline ~BasicObject()
+        {
+            release_order();
+            release_index();
+        }
+
+        inline allocator_type get_allocator() const noexcept
+        {
+            return this->entries.get_allocator();
+        }
+
+        /**
+         * @brief Check if the properties are kept in insertion order rather than sorted by name
+         *
+         * @return true
+         * @return false
+         * @since v1.5
+         */
+        inline bool keeps_order() const noexcept
+        {
+            return this->keep_order;
+        }
+
+        inline size_t size() const noexcept
+        {
+            return this->entries.size();
+        }
+
+        inline bool empty() const noexcept
+        {
+            return this->entries.empty();
+        }
+
+        inline void reserve(size_t capacity)
+        {
+            this->entries.reserve(capacity);
+        }
+
+        inline iterator begin() noexcept
+        {
+            return iterator(this, 0);
+        }
+
+        inline iterator end() noexcept
+        {
+            return iterator(this, this->entries.size());
+        }
+
+        inline const_iterator begin() const noexcept
+        {
+            return const_iterator(this, 0);
+        }
+
+        inline const_iterator end() const noexcept
+        {
+            return const_iterator(this, this->entries.size());
+        }
+
+        /**
+         * @brief Find a property by name
+         *
+         * @param name
+         * @return iterator the end iterator if there is no such property
+         * @since v1.5
+         */
+        inline iterator find(std::string_view name) noexcept
+        {
+            return begin() + position_of(name, Key::hash_of(name));
+        }
+
+        inline const_iterator find(std::string_view name) const noexcept
+        {
+            return begin() + position_of(name, Key::hash_of(name));
+        }
+
+        /**
+         * @brief Find a property by name with a hash computed beforehand by Key::hash_of
+         *
+         * @param name
+         * @param hash
+         * @return iterator the end iterator if there is no such property
+         * @since v1.5
+         */
+        inline iterator find(std::string_view name, size_t hash) noexcept
+        {
+            return begin() + position_of(name, hash);
+        }
+
+        inline const_iterator find(std::string_view name, size_t hash) const noexcept
+        {
+            return begin() + position_of(name, hash);
+        }
+
+        /**
+         * @brief Find a property by key, without hashing the name again. Keys of the same pool are compared by address
+         *
+         * @param key
+         * @return iterator the end iterator if there is no such property
+         * @since v1.5
+         */
+        inline iterator find(const Key &key) noexcept
+        {
+            return begin() + position_of(key, key.get_hash());
+        }
+
+        inline const_iterator find(const Key &key) const noexcept
+        {
+            return begin() + position_of(key, key.get_hash());
+        }
+
+        inline bool contains(std::string_view name) const noexcept
+        {
+            return find(name) != end();
+        }
+
+        /**
+         * @brief Get the value of a property
+         *
+         * @param name
+         * @return Value&
+         * @throw std::out_of_range if there is no such property
+         * @since v1.5
+         */
+        inline Value &at(std::string_view name)
+        {
+            iterator it = find(name);
+            if (it == end())
+                throw std::out_of_range("No property named: " + std::string(name));
+            return it->second;
+        }
+
+        inline const Value &at(std::string_view name) const
+        {
+            const_iterator it = find(name);
+            if (it == end())
+                throw std::out_of_range("No property named: " + std::string(name));
+            return it->second;
+        }
+
+        /**
+         * @brief Insert a property constructing its value from the arguments, unless the name is already used.
+         * The name is looked up once
+         *
+         * @param name
+         * @param args
+         * @return std::pair<iterator, bool> the property with that name and whether it was inserted
+         * @since v1.5
+         */
+        template <typename... Args>
+        std::pair<iterator, bool> try_emplace(std::string_view name, Args &&...args)
+        {
+            size_t position = position_of(name, Key::hash_of(name));
+            if (position < this->entries.size())
+                return std::pair<iterator, bool>(begin() + position, false);
+            return std::pair<iterator, bool>(insert(name, std::forward<Args>(args)...), true);
+        }
+
+        template <typename... Args>
+        std::pair<iterator, bool> emplace(std::string_view name, Args &&...args)
+        {
+            return try_emplace(name, std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Insert a property with the given key, unless its name is already used
+         *
+         * @param key
+         * @param args
+         * @return std::pair<iterator, bool> the property with that name and whether it was inserted
+         * @since v1.5
+         */
+        template <typename... Args>
+        std::pair<iterator, bool> emplace(Key &&key, Args &&...args)
+        {
+            size_t position = position_of(key, key.get_hash());
+            if (position < this->entries.size())
+                return std::pair<iterator, bool>(begin() + position, false);
+            return std::pair<iterator, bool>(insert(std::move(key), std::forward<Args>(args)...), true);
+        }
+    };
+
+    class Json;
+
+    /**
+     * @brief The events of Json::read. Derive from it and hide the events to handle, every event
+     * returns true to continue and false to stop the parsing. Strings and property names are only valid during the event
+     * @since v1.5
+     */
+    struct Handler
+    {
+        inline bool on_object_start() { return true; }
+        inline bool on_object_end() { return true; }
+        inline bool on_array_start() { return true; }
+        inline bool on_array_end() { return true; }
+        inline bool on_key(std::string_view) { return true; }
+        inline bool on_string(std::string_view) { return true; }
+        inline bool on_number(const Json &) { return true; }
+        inline bool on_bool(bool) { return true; }
+        inline bool on_null() { return true; }
+    };
+
+    /**
+     * @brief The Json class allows to parse a json string
+     *
+     */
+    class Json
+    {
+    public:
+        friend class Document;
+        friend class FrozenDocument;
+        friend class JsonLines;
+        friend class Builder;
+        friend class Path;
+        friend class Binder;
+        template <typename Handler>
+        friend class PushParser;
+
+        using Array = StableVector<Json>;
+        using Object = BasicObject<Json>;
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    private:
+        /**
+         * @brief A borrowed string with escape sequences, decoded when it is read
+         */
+        struct RawString
+        {
+            std::string_view raw;
+            std::pmr::memory_resource *resource;
+        };
+
+        /**
+         * @brief The state shared by the recursive descent. The source keeps alive the string that lazy subtrees
+         * point into: a mapped file, or a copy of the parsed string made when the first subtree is deferred
+         */
+        struct ParseContext
+        {
+            std::string_view str;
+            Scanner scanner;
+            std::pmr::memory_resource *resource;
+            ParseOptions options;
+            std::shared_ptr<const char> source;
+            size_t depth = 0;
+        };
+
+        std::variant<std::nullptr_t, bool, double, int64_t, uint64_t, std::pmr::string, Array, Object, std::string_view, RawString> value;
+
+        static Key make_key(ParseContext &context, std::string_view raw, bool has_escapes)
+        {
+            if (has_escapes)
+            {
+                std::pmr::string name = decode_string(raw, context.resource);
+                if (context.options.keys != nullptr)
+                    return context.options.keys->intern(name);
+                JPP_STATS_ADD(string_bytes_copied, name.length());
+                return Key(name, context.resource);
+            }
+            if (context.options.keys != nullptr)
+                return context.options.keys->intern(raw);
+            if (context.options.borrow_strings)
+                return Key::borrow(raw);
+            JPP_STATS_ADD(string_bytes_copied, raw.length());
+            return Key(raw, context.resource);
+        }
+
+        Object parse_object(ParseContext &context, size_t &index)
+        {
+            Object object(context.resource, context.options.keep_order);
+            Jpp::Token next;
+            JPP_STATS_ADD(objects, 1);
+            JPP_STATS_DEPTH(context.depth);
+            std::string_view current_property;
+            bool property_has_escapes = false;
+            Jpp::Json current_value;
+
+            index = context.scanner.next();
+
+            while (true)
+            {
+                next = match_next(context.str, index);
+
+                switch (next)
+                {
+                case Jpp::Token::END:
+                    throw std::invalid_argument("Unexpected the end of the string, expected a '}' at position: " + std::to_string(index));
+                case Jpp::Token::ARRAY_START:
+                    throw std::runtime_error("Unexpected the start of an array, expected a property name at position: " + std::to_string(index));
+                case Jpp::Token::ARRAY_END:
+                    throw std::runtime_error("Unexpected the end of an array, expected a property name at position: " + std::to_string(index));
+                case Jpp::Token::ALPHA:
+                    throw std::runtime_error("Unexpected a boolean value, expected a property name at position: " + std::to_string(index));
+                case Jpp::Token::NUMBER:
+                    throw std::runtime_error("Unexpected a number value, expected a property name at position: " + std::to_string(index));
+                case Jpp::Token::OBJECT_START:
+                    throw std::runtime_error("Unexpected the start of an object, expected a property name at position: " + std::to_string(index));
+                case Jpp::Token::OBJECT_END:
+                    index = context.scanner.next();
+                    return object;
+                case Jpp::Token::SEPARATOR:
+                    throw std::runtime_error("Unexpected separator, expected a property name at position: " + std::to_string(index));
+                case Jpp::Token::STRING:
+                    current_property = scan_string(context, index, property_has_escapes);
+                    break;
+                }
+
+                if (index >= context.str.length() || context.str[index] != ':')
+                    throw std::runtime_error("Expected ':' at position: " + std::to_string(index));
+
+                index = context.scanner.next();
+
+                next = match_next(context.str, index);
+
+                switch (next)
+                {
+                case Jpp::Token::END:
+                    throw std::runtime_error("Unexpected the end of the string, a value is expected at position: " + std::to_string(index));
+                case Jpp::Token::ARRAY_START:
+                    if (context.options.borrow_strings)
+                        current_value = Jpp::Json(parse_array(context, index));
+                    else
+                        current_value = get_unresolved_object(context, index, false);
+                    break;
+                case Jpp::Token::ARRAY_END:
+                    throw std::runtime_error("Unexpected the end of an array, a value is expected at position: " + std::to_string(index));
+                case Jpp::Token::OBJECT_START:
+                    if (context.options.borrow_strings)
+                        current_value = Jpp::Json(parse_object(context, index));
+                    else
+                        current_value = get_unresolved_object(context, index, true);
+                    break;
+                case Jpp::Token::OBJECT_END:
+                    throw std::runtime_error("Unexpected the end of the object, a value is expected at position: " + std::to_string(index));
+                case Jpp::Token::ALPHA:
+                    if (context.str[index] == 'n')
+                        current_value = Jpp::Json(parse_null(context, index));
+                    else
+                        current_value = Jpp::Json(parse_boolean(context, index));
+                    break;
+                case Jpp::Token::NUMBER:
+                    current_value = parse_number(context, index);
+                    break;
+                case Jpp::Token::STRING:
+                    current_value = parse_string_value(context, index);
+                    break;
+                case Jpp::Token::SEPARATOR:
+                    throw std::runtime_error("Unexpected separator, a value is expected at position: " + std::to_string(index));
+                }
+
+                next = match_next(context.str, index);
+                if (next != Jpp::Token::SEPARATOR && next != Jpp::Token::OBJECT_END)
+                    throw std::runtime_error("Expected a ',' or the end of the object at position: " + std::to_string(index));
+
+                index = context.scanner.next();
+
+                object.append_unique(make_key(context, current_property, property_has_escapes), std::move(current_value));
+
+                if (next == Jpp::Token::OBJECT_END)
+                {
+                    object.sort_by_name();
+                    return object;
+                }
+            }
+        }
+
+        Array parse_array(ParseContext &context, size_t &index)
+        {
+            Array array(context.resource);
+            JPP_STATS_ADD(arrays, 1);
+            JPP_STATS_DEPTH(context.depth);
+
+            index = context.scanner.next();
+            parse_elements(context, index, array, false);
+            return array;
+        }
+
+        /**
+         * @brief Parse the elements of an array up to its closing bracket. The chunks of a parallel parse
+         * end at the separator after their last element instead, where the string is cut
+         */
+        void parse_elements(ParseContext &context, size_t &index, Array &array, bool is_chunk)
+        {
+            Jpp::Token next;
+            Jpp::Json current_value;
+
+            while (true)
+            {
+                next = match_next(context.str, index);
+
+                switch (next)
+                {
+                case Jpp::Token::END:
+                    if (is_chunk)
+                        return;
+                    throw std::runtime_error("Unexpected the end of the string, the end of the array is expected at position: " + std::to_string(index));
+                case Jpp::Token::ARRAY_START:
+                    current_value = Jpp::Json(parse_array(context, index));
+                    break;
+                case Jpp::Token::ARRAY_END:
+                    index = context.scanner.next();
+                    return;
+                case Jpp::Token::OBJECT_START:
+                    current_value = Jpp::Json(parse_object(context, index));
+                    break;
+                case Jpp::Token::OBJECT_END:
+                    throw std::runtime_error("Unexpected '}' token, a value is expected at position: " + std::to_string(index));
+                case Jpp::Token::ALPHA:
+                    if (context.str[index] == 'n')
+                        current_value = Jpp::Json(parse_null(context, index));
+                    else
+                        current_value = Jpp::Json(parse_boolean(context, index));
+                    break;
+                case Jpp::Token::NUMBER:
+                    current_value = parse_number(context, index);
+                    break;
+                case Jpp::Token::STRING:
+                    current_value = parse_string_value(context, index);
+                    break;
+                case Jpp::Token::SEPARATOR:
+                    throw std::runtime_error("Unexpected separator, a value is expected at position: " + std::to_string(index));
+                }
+
+                next = match_next(context.str, index);
+                if (next == Jpp::Token::END && is_chunk)
+                {
+                    array.push_back(std::move(current_value));
+                    return;
+                }
+                if (next != Jpp::Token::SEPARATOR && next != Jpp::Token::ARRAY_END)
+                    throw std::runtime_error("Expected a ',' or the end of the array at position: " + std::to_string(index));
+
+                index = context.scanner.next();
+
+                array.push_back(std::move(current_value));
+
+                if (next == Jpp::Token::ARRAY_END)
+                    return;
+            }
+        }
+
+        /**
+         * @brief Get the content of the string starting at index. The closing quote is the next structural
+         */
+        static std::string_view scan_string(ParseContext &context, size_t &index, bool &has_escapes)
+        {
+            size_t start = index + 1;
+            size_t end = context.scanner.next();
+
+            if (end >= context.str.length())
+                throw std::runtime_error("Expected the end of the string");
+            std::string_view content = context.str.substr(start, end - start);
+            size_t new_line = content.find('\n');
+            if (new_line != std::string_view::npos)
+                throw std::runtime_error("Unexpected end of the line while parsing the string: '" + std::string(content.substr(0, new_line)) + "' at position: " + std::to_string(start + new_line));
+            has_escapes = content.find('\\') != std::string_view::npos;
+            index = context.scanner.next();
+            return content;
+        }
+
+        /**
+         * @brief Get the number, boolean or null starting at index. It ends where the next structural or white space begins
+         */
+        static std::string_view scan_token(ParseContext &context, size_t &index)
+        {
+            size_t start = index;
+            index = context.scanner.next();
+            size_t end = index;
+            while (end > start && is_space(context.str[end - 1]))
+                --end;
+            return context.str.substr(start, end - start);
+        }
+
+        /**
+         * @brief Move index to the closing bracket of the object or array starting at it
+         */
+        static void skip_container(ParseContext &context, size_t &index)
+        {
+            int level = 1;
+
+            while (level > 0)
+            {
+                index = context.scanner.next();
+                if (index >= context.str.length())
+                    throw std::runtime_error("Unexpected end of the string");
+
+                switch (context.str[index])
+                {
+                case '{':
+                case '[':
+                    level++;
+                    break;
+                case '}':
+                case ']':
+                    level--;
+                    break;
+                }
+            }
+        }
+
+        /**
+         * @brief Skip the value starting at index without parsing it
+         */
+        static void skip_value(ParseContext &context, size_t &index)
+        {
+            bool has_escapes;
+
+            switch (match_next(context.str, index))
+            {
+            case Jpp::Token::OBJECT_START:
+            case Jpp::Token::ARRAY_START:
+                skip_container(context, index);
+                index = context.scanner.next();
+                break;
+            case Jpp::Token::STRING:
+                scan_string(context, index, has_escapes);
+                break;
+            case Jpp::Token::NUMBER:
+            case Jpp::Token::ALPHA:
+                scan_token(context, index);
+                break;
+            default:
+                throw std::runtime_error("Unexpected " + std::string(1, context.str[index]) + " token, a value is expected at position: " + std::to_string(index));
+            }
+        }
+
+        /**
+         * @brief Parse the value starting at index, which may be a primitive. Objects and arrays are parsed from their own
+         * range of the string, so their lazy subtrees keep a copy of that range only
+         */
+        static Json parse_value(ParseContext &context, size_t &index)
+        {
+            size_t start = index;
+
+            switch (match_next(context.str, index))
+            {
+            case Jpp::Token::OBJECT_START:
+            case Jpp::Token::ARRAY_START:
+            {
+                Json json;
+                skip_container(context, index);
+                json.parse(context.str.substr(start, index + 1 - start), context.options, context.resource);
+                index = context.scanner.next();
+                return json;
+            }
+            case Jpp::Token::STRING:
+                return parse_string_value(context, index);
+            case Jpp::Token::NUMBER:
+                return parse_number(context, index);
+            case Jpp::Token::ALPHA:
+                if (context.str[index] == 'n')
+                    return Json(parse_null(context, index));
+                return Json(parse_boolean(context, index));
+            default:
+                throw std::runtime_error("Unexpected " + std::string(1, context.str[index]) + " token, a value is expected at position: " + std::to_string(index));
+            }
+        }
+
+        static int hex_digit(char ch) noexcept
+        {
+            if (ch >= '0' && ch <= '9')
+                return ch - '0';
+            if ((ch | 0x20) >= 'a' && (ch | 0x20) <= 'f')
+                return (ch | 0x20) - 'a' + 10;
+            return -1;
+        }
+
+        /**
+         * @brief Read the four hexadecimal digits of a unicode escape sequence starting at position
+         */
+        static int32_t read_code_unit(std::string_view raw, size_t position) noexcept
+        {
+            int32_t code = 0;
+
+            if (raw.length() - position < 4)
+                return -1;
+            for (size_t i = position; i < position + 4; ++i)
+            {
+                int digit = hex_digit(raw[i]);
+                if (digit < 0)
+                    return -1;
+                code = code << 4 | digit;
+            }
+            return code;
+        }
+
+        template <typename String>
+        static void append_utf8(String &value, uint32_t code)
+        {
+            if (code < 0x80)
+                value += static_cast<char>(code);
+            else if (code < 0x800)
+            {
+                value += static_cast<char>(0xc0 | code >> 6);
+                value += static_cast<char>(0x80 | (code & 0x3f));
+            }
+            else if (code < 0x10000)
+            {
+                value += static_cast<char>(0xe0 | code >> 12);
+                value += static_cast<char>(0x80 | (code >> 6 & 0x3f));
+                value += static_cast<char>(0x80 | (code & 0x3f));
+            }
+            else
+            {
+                value += static_cast<char>(0xf0 | code >> 18);
+                value += static_cast<char>(0x80 | (code >> 12 & 0x3f));
+                value += static_cast<char>(0x80 | (code >> 6 & 0x3f));
+                value += static_cast<char>(0x80 | (code & 0x3f));
+            }
+        }
+
+        /**
+         * @brief Decode the unicode escape sequence at escape into UTF-8, joining surrogate pairs.
+         * Unpaired surrogates become U+FFFD
+         *
+         * @return size_t the length of the decoded escape sequences
+         */
+        template <typename String>
+        static size_t append_code_point(std::string_view raw, size_t escape, String &value)
+        {
+            int32_t code = read_code_unit(raw, escape + 2);
+
+            if (code < 0)
+                throw std::runtime_error("Invalid escape sequence: " + std::string(raw.substr(escape, 6)));
+            if (code >= 0xdc00 && code <= 0xdfff)
+                code = 0xfffd;
+            else if (code >= 0xd800 && code <= 0xdbff)
+            {
+                int32_t low = raw.substr(escape + 6, 2) == "\\u" ? read_code_unit(raw, escape + 8) : -1;
+                if (low < 0xdc00 || low > 0xdfff)
+                {
+                    append_utf8(value, 0xfffd);
+                    return 6;
+                }
+                append_utf8(value, 0x10000 + ((static_cast<uint32_t>(code) - 0xd800) << 10) + (static_cast<uint32_t>(low) - 0xdc00));
+                return 12;
+            }
+            append_utf8(value, static_cast<uint32_t>(code));
+            return 6;
+        }
+
+        /**
+         * @brief Decode the escape sequences of a string: the runs between backslashes are found
+         * with memchr and copied at once, and every escape of RFC 8259 is decoded in the same pass
+         */
+        template <typename String>
+        static void append_decoded(std::string_view raw, String &value)
+        {
+            size_t index = 0;
+
+            value.reserve(value.length() + raw.length());
+            while (index < raw.length())
+            {
+                size_t escape = raw.find('\\', index);
+                if (escape == std::string_view::npos || escape + 1 >= raw.length())
+                {
+                    value.append(raw.substr(index));
+                    return;
+                }
+                value.append(raw.substr(index, escape - index));
+                index = escape + 2;
+                switch (raw[escape + 1])
+                {
+                case 'n':
+                    value += '\n';
+                    break;
+                case 't':
+                    value += '\t';
+                    break;
+                case 'r':
+                    value += '\r';
+                    break;
+                case 'v':
+                    value += '\v';
+                    break;
+                case 'b':
+                    value += '\b';
+                    break;
+                case 'f':
+                    value += '\f';
+                    break;
+                case 'u':
+                    index = escape + append_code_point(raw, escape, value);
+                    break;
+                default:
+                    value += raw[escape + 1];
+                    break;
+                }
+            }
+        }
+
+        static std::pmr::string decode_string(std::string_view raw, std::pmr::memory_resource *resource)
+        {
+            std::pmr::string value(resource);
+            append_decoded(raw, value);
+            return value;
+        }
+
+        template <typename Handler>
+        static bool read_object(ParseContext &context, size_t &index, Handler &handler, std::pmr::string &buffer, Json &number)
+        {
+            std::string_view str = context.str;
+
+            if (!handler.on_object_start())
+                return false;
+            index = context.scanner.next();
+
+            while (true)
+            {
+                switch (match_next(str, index))
+                {
+                case Jpp::Token::END:
+                    throw std::invalid_argument("Unexpected the end of the string, expected a '}' at position: " + std::to_string(index));
+                case Jpp::Token::ARRAY_START:
+                    throw std::runtime_error("Unexpected the start of an array, expected a property name at position: " + std::to_string(index));
+                case Jpp::Token::ARRAY_END:
+                    throw std::runtime_error("Unexpected the end of an array, expected a property name at position: " + std::to_string(index));
+                case Jpp::Token::ALPHA:
+                    throw std::runtime_error("Unexpected a boolean value, expected a property name at position: " + std::to_string(index));
+                case Jpp::Token::NUMBER:
+                    throw std::runtime_error("Unexpected a number value, expected a property name at position: " + std::to_string(index));
+                case Jpp::Token::OBJECT_START:
+                    throw std::runtime_error("Unexpected the start of an object, expected a property name at position: " + std::to_string(index));
+                case Jpp::Token::OBJECT_END:
+                    index = context.scanner.next();
+                    return handler.on_object_end();
+                case Jpp::Token::SEPARATOR:
+                    throw std::runtime_error("Unexpected separator, expected a property name at position: " + std::to_string(index));
+                case Jpp::Token::STRING:
+                    if (!handler.on_key(read_string(context, index, buffer)))
+                        return false;
+                    break;
+                }
+
+                if (index >= str.length() || str[index] != ':')
+                    throw std::runtime_error("Expected ':' at position: " + std::to_string(index));
+
+                index = context.scanner.next();
+
+                switch (match_next(str, index))
+                {
+                case Jpp::Token::END:
+                    throw std::runtime_error("Unexpected the end of the string, a value is expected at position: " + std::to_string(index));
+                case Jpp::Token::ARRAY_END:
+                    throw std::runtime_error("Unexpected the end of an array, a value is expected at position: " + std::to_string(index));
+                case Jpp::Token::OBJECT_END:
+                    throw std::runtime_error("Unexpected the end of the object, a value is expected at position: " + std::to_string(index));
+                case Jpp::Token::SEPARATOR:
+                    throw std::runtime_error("Unexpected separator, a value is expected at position: " + std::to_string(index));
+                default:
+                    if (!read_value(context, index, handler, buffer, number))
+                        return false;
+                    break;
+                }
+
+                Jpp::Token next = match_next(str, index);
+                if (next != Jpp::Token::SEPARATOR && next != Jpp::Token::OBJECT_END)
+                    throw std::runtime_error("Expected a ',' or the end of the object at position: " + std::to_string(index));
+
+                index = context.scanner.next();
+
+                if (next == Jpp::Token::OBJECT_END)
+                    return handler.on_object_end();
+            }
+        }
+
+        template <typename Handler>
+        static bool read_array(ParseContext &context, size_t &index, Handler &handler, std::pmr::string &buffer, Json &number)
+        {
+            std::string_view str = context.str;
+
+            if (!handler.on_array_start())
+                return false;
+            index = context.scanner.next();
+
+            while (true)
+            {
+                switch (match_next(str, index))
+                {
+                case Jpp::Token::END:
+                    throw std::runtime_error("Unexpected the end of the string, the end of the array is expected at position: " + std::to_string(index));
+                case Jpp::Token::ARRAY_END:
+                    index = context.scanner.next();
+                    return handler.on_array_end();
+                case Jpp::Token::OBJECT_END:
+                    throw std::runtime_error("Unexpected '}' token, a value is expected at position: " + std::to_string(index));
+                case Jpp::Token::SEPARATOR:
+                    throw std::runtime_error("Unexpected separator, a value is expected at position: " + std::to_string(index));
+                default:
+                    if (!read_value(context, index, handler, buffer, number))
+                        return false;
+                    break;
+                }
+
+                Jpp::Token next = match_next(str, index);
+                if (next != Jpp::Token::SEPARATOR && next != Jpp::Token::ARRAY_END)
+                    throw std::runtime_error("Expected a ',' or the end of the array at position: " + std::to_string(index));
+
+                index = context.scanner.next();
+
+                if (next == Jpp::Token::ARRAY_END)
+                    return handler.on_array_end();
+            }
+        }
+
+        /**
+         * @brief Report the value starting at index, which must be an object, an array, a string or a primitive
+         */
+        template <typename Handler>
+        static bool read_value(ParseContext &context, size_t &index, Handler &handler, std::pmr::string &buffer, Json &number)
+        {
+            switch (match_next(context.str, index))
+            {
+            case Jpp::Token::OBJECT_START:
+                return read_object(context, index, handler, buffer, number);
+            case Jpp::Token::ARRAY_START:
+                return read_array(context, index, handler, buffer, number);
+            case Jpp::Token::STRING:
+                return handler.on_string(read_string(context, index, buffer));
+            case Jpp::Token::NUMBER:
+            {
+                size_t start = index;
+                std::string_view token = scan_token(context, index);
+                if (!convert_number(token, number))
+                    throw std::runtime_error("Invalid number: " + std::string(token) + " at position: " + std::to_string(start));
+                return handler.on_number(static_cast<const Json &>(number));
+            }
+            case Jpp::Token::ALPHA:
+            {
+                std::string_view token = scan_token(context, index);
+                if (token == "null")
+                    return handler.on_null();
+                if (token == "true" || token == "false")
+                    return handler.on_bool(token == "true");
+                throw std::runtime_error("Unrecognized token: " + std::string(token) + " at position: " + std::to_string(index));
+            }
+            default:
+                throw std::runtime_error("Unexpected " + std::string(1, context.str[index]) + " token at position: " + std::to_string(index));
+            }
+        }
+
+        /**
+         * @brief Scan a string for the handler. Strings with escape sequences are decoded into the buffer,
+         * which is reused so that steady state parsing does not allocate
+         */
+        static std::string_view read_string(ParseContext &context, size_t &index, std::pmr::string &buffer)
+        {
+            bool has_escapes;
+            std::string_view raw = scan_string(context, index, has_escapes);
+
+            if (!has_escapes)
+                return raw;
+            buffer.clear();
+            append_decoded(raw, buffer);
+            return buffer;
+        }
+
+        static Json parse_string_value(ParseContext &context, size_t &index)
+        {
+            bool has_escapes;
+            std::string_view raw = scan_string(context, index, has_escapes);
+            Json json;
+
+            JPP_STATS_ADD(strings, 1);
+            JPP_STATS_ADD(string_bytes_copied, context.options.borrow_strings ? 0 : raw.length());
+            json.type = JSON_STRING;
+            if (!context.options.borrow_strings)
+                json.value.emplace<std::pmr::string>(has_escapes ? decode_string(raw, context.resource) : std::pmr::string(raw, context.resource));
+            else if (has_escapes)
+                json.value.emplace<RawString>(RawString{raw, context.resource});
+            else
+                json.value.emplace<std::string_view>(raw);
+            return json;
+        }
+
+        static Json parse_number(ParseContext &context, size_t &index)
+        {
+            size_t start = index;
+            std::string_view substr = scan_token(context, index);
+            Json number;
+
+            JPP_STATS_ADD(numbers, 1);
+            if (!convert_number(substr, number))
+                throw std::runtime_error("Invalid number: " + std::string(substr) + " at position: " + std::to_string(start));
+            return number;
+        }
+
+        /**
+         * @brief Convert a number without going through the locale. Integers are kept exact
+         * as int64 or, when they are too large, as uint64; fractions and exponents become doubles
+         */
+        static bool convert_number(std::string_view str, Json &number) noexcept
+        {
+            const char *first = str.data();
+            const char *last = first + str.length();
+            int64_t integer;
+            std::from_chars_result result = std::from_chars(first, last, integer);
+
+            number.type = JSON_NUMBER;
+            if (result.ec == std::errc() && result.ptr == last)
+            {
+                number.value = integer;
+                return true;
+            }
+            if (result.ec == std::errc::result_out_of_range && *first != '-')
+            {
+                uint64_t unsigned_integer;
+                result = std::from_chars(first, last, unsigned_integer);
+                if (result.ec == std::errc() && result.ptr == last)
+                {
+                    number.value = unsigned_integer;
+                    return true;
+                }
+            }
+
+            double floating;
+            result = std::from_chars(first, last, floating);
+            if (result.ec != std::errc() || result.ptr != last)
+                return false;
+            number.value = floating;
+            return true;
+        }
+
+        static bool parse_boolean(ParseContext &context, size_t &index)
+        {
+            std::string_view substr = scan_token(context, index);
+
+            JPP_STATS_ADD(booleans, 1);
+            if (substr == "true")
+                return true;
+            if (substr == "false")
+                return false;
+            throw std::runtime_error("Unrecognized token: " + std::string(substr) + " at position: " + std::to_string(index));
+        }
+
+        static std::nullptr_t parse_null(ParseContext &context, size_t &index)
+        {
+            std::string_view substr = scan_token(context, index);
+
+            JPP_STATS_ADD(nulls, 1);
+            if (substr == "null")
+                return nullptr;
+
+            throw std::runtime_error("Unrecognized token: " + std::string(substr) + " at position: " + std::to_string(index));
+        }
+
+        std::shared_ptr<const char> source;
+        size_t source_begin = 0;
+        size_t source_end = 0;
+        KeyPool *source_keys = nullptr;
+        JsonType type;
+        bool is_resolved;
+        bool source_keep_order = false;
+
+        static Token match_next(std::string_view str, size_t &index)
+        {
+            if (index >= str.length())
+                return Jpp::Token::END;
+            switch (str[index])
+            {
+            case '{':
+                return Jpp::Token::OBJECT_START;
+            case '}':
+                return Jpp::Token::OBJECT_END;
+            case ',':
+                return Jpp::Token::SEPARATOR;
+            case '"':
+            case '\'':
+                return Jpp::Token::STRING;
+            case '[':
+                return Jpp::Token::ARRAY_START;
+            case ']':
+                return Jpp::Token::ARRAY_END;
+            }
+            if ((str[index] >= '0' && str[index] <= '9') || str[index] == '-')
+                return Jpp::Token::NUMBER;
+            if (isalpha(str[index]))
+                return Jpp::Token::ALPHA;
+            throw std::runtime_error("Unexpected " + std::string(1, str[index]) + " token at position: " + std::to_string(index));
+        }
+
+        static inline bool is_space(char ch) noexcept
+        {
+            return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\v';
+        }
+
+        inline void write_object(Writer &writer) const
+        {
+            resolve_shared();
+            const Object &children = std::get<Object>(this->value);
+            bool first = true;
+
+            writer.put('{');
+            for (const auto &child : children)
+            {
+                if (!first)
+                    writer.write(", ");
+                first = false;
+                write_string(writer, child.first);
+                writer.put(':');
+                child.second.write(writer);
+            }
+            writer.put('}');
+        }
+
+        inline void write_array(Writer &writer) const
+        {
+            resolve_shared();
+            const Array &elements = std::get<Array>(this->value);
+
+            writer.put('[');
+            for (size_t i = 0; i < elements.size(); ++i)
+            {
+                if (i > 0)
+                    writer.put(',');
+                elements[i].write(writer);
+            }
+            writer.put(']');
+        }
+
+        static inline bool needs_escape(char ch) noexcept
+        {
+            return ch == '"' || ch == '\\' || static_cast<unsigned char>(ch) < 0x20;
+        }
+
+        /**
+         * @brief Get the position of the first character from start that must be escaped: a quote, a backslash
+         * or a control character. The string is checked 16 bytes at a time with SSE2
+         */
+        static size_t find_escape(std::string_view str, size_t start) noexcept
+        {
+            size_t i = start;
+
+#ifdef JPP_SIMD_X86
+            const __m128i quote = _mm_set1_epi8('"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i control = _mm_set1_epi8(0x1f);
+            for (; i + 16 <= str.length(); i += 16)
+            {
+                const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str.data() + i));
+                // the unsigned minimum with 0x1f equals the byte only for the control characters
+                const __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                                                     _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+                if (mask != 0)
+                    return i + std::countr_zero(mask);
+            }
+#endif
+            for (; i < str.length(); ++i)
+                if (needs_escape(str[i]))
+                    return i;
+            return str.length();
+        }
+
+        static void write_escape(Writer &writer, char ch)
+        {
+            static const char digits[] = "0123456789abcdef";
+
+            switch (ch)
+            {
+            case '"':
+                writer.write("\\\"");
+                break;
+            case '\\':
+                writer.write("\\\\");
+                break;
+            case '\n':
+                writer.write("\\n");
+                break;
+            case '\t':
+                writer.write("\\t");
+                break;
+            case '\r':
+                writer.write("\\r");
+                break;
+            case '\b':
+                writer.write("\\b");
+                break;
+            case '\f':
+                writer.write("\\f");
+                break;
+            default:
+                writer.write("\\u00");
+                writer.put(digits[(ch >> 4) & 0xf]);
+                writer.put(digits[ch & 0xf]);
+                break;
+            }
+        }
+
+        /**
+         * @brief Write a quoted string, copying the runs without characters to escape at once
+         */
+        static void write_string(Writer &writer, std::string_view str)
+        {
+            size_t start = 0;
+
+            writer.put('"');
+            while (true)
+            {
+                size_t escape = find_escape(str, start);
+                writer.write(str.substr(start, escape - start));
+                if (escape >= str.length())
+                    break;
+                write_escape(writer, str[escape]);
+                start = escape + 1;
+            }
+            writer.put('"');
+        }
+
+        /**
+         * @brief Write a number with the fewest digits that parse back to the same value, without going through the locale.
+         * Doubles without a fractional part are written as integers, infinities and NaN as null
+         */
+        inline void write_number(Writer &writer) const
+        {
+            char buffer[32];
+            std::to_chars_result result;
+
+            if (const double *num = std::get_if<double>(&this->value))
+            {
+                if (!std::isfinite(*num))
+                {
+                    writer.write("null");
+                    return;
+                }
+                result = std::to_chars(buffer, buffer + sizeof(buffer), *num);
+            }
+            else if (const int64_t *num = std::get_if<int64_t>(&this->value))
+                result = std::to_chars(buffer, buffer + sizeof(buffer), *num);
+            else
+                result = std::to_chars(buffer, buffer + sizeof(buffer), std::get<uint64_t>(this->value));
+            writer.write(std::string_view(buffer, static_cast<size_t>(result.ptr - buffer)));
+        }
+
+        /**
+         * @brief The tags of the binary format, see to_binary
+         */
+        enum BinaryTag : uint8_t
+        {
+            BINARY_NULL,
+            BINARY_FALSE,
+            BINARY_TRUE,
+            BINARY_INT64,
+            BINARY_UINT64,
+            BINARY_DOUBLE,
+            BINARY_STRING,
+            BINARY_ARRAY,
+            BINARY_OBJECT,
+            BINARY_ORDERED_OBJECT
+        };
+
+        static constexpr std::string_view binary_header = std::string_view("Jpp\x01", 4);
+
+        static inline void put_varint(std::string &out, uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                out += static_cast<char>((value & 0x7f) | 0x80);
+                value >>= 7;
+            }
+            out += static_cast<char>(value);
+        }
+
+        static inline void put_fixed(std::string &out, uint64_t value, int bytes)
+        {
+            for (int i = 0; i < bytes; ++i)
+                out += static_cast<char>((value >> (8 * i)) & 0xff);
+        }
+
+        /**
+         * @brief Write the size of the container that starts after the position, in the four bytes reserved at it
+         */
+        static void patch_size(std::string &out, size_t position)
+        {
+            size_t size = out.length() - position - 4;
+            if (size > UINT32_MAX)
+                throw std::length_error("A container is too large for the binary format");
+            for (int i = 0; i < 4; ++i)
+                out[position + i] = static_cast<char>((size >> (8 * i)) & 0xff);
+        }
+
+        void write_binary(std::string &out)
+        {
+            if (!is_resolved)
+                resolve();
+            switch (this->type)
+            {
+            case JSON_NULL:
+                out += static_cast<char>(BINARY_NULL);
+                break;
+            case JSON_BOOLEAN:
+                out += static_cast<char>(std::get<bool>(this->value) ? BINARY_TRUE : BINARY_FALSE);
+                break;
+            case JSON_NUMBER:
+                if (const int64_t *num = std::get_if<int64_t>(&this->value))
+                {
+                    out += static_cast<char>(BINARY_INT64);
+                    put_varint(out, (static_cast<uint64_t>(*num) << 1) ^ static_cast<uint64_t>(*num >> 63));
+                }
+                else if (const uint64_t *num = std::get_if<uint64_t>(&this->value))
+                {
+                    out += static_cast<char>(BINARY_UINT64);
+                    put_varint(out, *num);
+                }
+                else
+                {
+                    out += static_cast<char>(BINARY_DOUBLE);
+                    put_fixed(out, std::bit_cast<uint64_t>(std::get<double>(this->value)), 8);
+                }
+                break;
+            case JSON_STRING:
+            {
+                std::string_view str = string_value();
+                out += static_cast<char>(BINARY_STRING);
+                put_varint(out, str.length());
+                out.append(str);
+                break;
+            }
+            case JSON_ARRAY:
+            {
+                Array &elements = std::get<Array>(this->value);
+                out += static_cast<char>(BINARY_ARRAY);
+                size_t position = out.length();
+                out.append(4, '\0');
+                put_varint(out, elements.size());
+                for (Json &element : elements)
+                    element.write_binary(out);
+                patch_size(out, position);
+                break;
+            }
+            case JSON_OBJECT:
+            {
+                Object &children = std::get<Object>(this->value);
+                out += static_cast<char>(children.keeps_order() ? BINARY_ORDERED_OBJECT : BINARY_OBJECT);
+                size_t position = out.length();
+                out.append(4, '\0');
+                put_varint(out, children.size());
+                for (auto &child : children)
+                {
+                    std::string_view name = child.first;
+                    put_varint(out, name.length());
+                    out.append(name);
+                    child.second.write_binary(out);
+                }
+                patch_size(out, position);
+                break;
+            }
+            }
+        }
+
+        static uint64_t get_varint(std::string_view data, size_t &index)
+        {
+            uint64_t value = 0;
+
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                if (index >= data.length())
+                    throw std::runtime_error("Unexpected the end of the binary JSON");
+                uint8_t byte = static_cast<uint8_t>(data[index++]);
+                value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                    return value;
+            }
+            throw std::runtime_error("Invalid length in the binary JSON at position: " + std::to_string(index));
+        }
+
+        static uint64_t get_fixed(std::string_view data, size_t &index, int bytes)
+        {
+            uint64_t value = 0;
+
+            if (data.length() - index < static_cast<size_t>(bytes))
+                throw std::runtime_error("Unexpected the end of the binary JSON");
+            for (int i = 0; i < bytes; ++i)
+                value |= static_cast<uint64_t>(static_cast<uint8_t>(data[index++])) << (8 * i);
+            return value;
+        }
+
+        static std::string_view get_bytes(std::string_view data, size_t &index)
+        {
+            uint64_t length = get_varint(data, index);
+            if (data.length() - index < length)
+                throw std::runtime_error("Unexpected the end of the binary JSON");
+            index += length;
+            return data.substr(index - length, length);
+        }
+
+        static Json read_binary(std::string_view data, size_t &index, std::pmr::memory_resource *resource)
+        {
+            if (index >= data.length())
+                throw std::runtime_error("Unexpected the end of the binary JSON");
+            size_t start = index;
+            switch (static_cast<uint8_t>(data[index++]))
+            {
+            case BINARY_NULL:
+                return Json(nullptr);
+            case BINARY_FALSE:
+                return Json(false);
+            case BINARY_TRUE:
+                return Json(true);
+            case BINARY_INT64:
+            {
+                uint64_t zigzag = get_varint(data, index);
+                return Json(static_cast<int64_t>((zigzag >> 1) ^ (~(zigzag & 1) + 1)));
+            }
+            case BINARY_UINT64:
+                return Json(get_varint(data, index));
+            case BINARY_DOUBLE:
+                return Json(std::bit_cast<double>(get_fixed(data, index, 8)));
+            case BINARY_STRING:
+                return Json(std::pmr::string(get_bytes(data, index), resource));
+            case BINARY_ARRAY:
+            {
+                uint64_t size = get_fixed(data, index, 4);
+                if (size > data.length() - index)
+                    throw std::runtime_error("Unexpected the end of the binary JSON");
+                size_t end = index + size;
+                uint64_t count = get_varint(data.substr(0, end), index);
+                Array elements(resource);
+                elements.reserve(std::min<uint64_t>(count, end - index));
+                for (uint64_t i = 0; i < count; ++i)
+                    elements.push_back(read_binary(data.substr(0, end), index, resource));
+                if (index != end)
+                    throw std::runtime_error("Invalid size of the array in the binary JSON at position: " + std::to_string(start));
+                return Json(std::move(elements));
+            }
+            case BINARY_OBJECT:
+            case BINARY_ORDERED_OBJECT:
+            {
+                bool keep_order = data[start] == BINARY_ORDERED_OBJECT;
+                uint64_t size = get_fixed(data, index, 4);
+                if (size > data.length() - index)
+                    throw std::runtime_error("Unexpected the end of the binary JSON");
+                size_t end = index + size;
+                uint64_t count = get_varint(data.substr(0, end), index);
+                std::string_view content = data.substr(0, end);
+                Object children(resource, keep_order);
+                children.reserve(std::min<uint64_t>(count, end - index));
+                for (uint64_t i = 0; i < count; ++i)
+                {
+                    Key key(get_bytes(content, index), resource);
+                    children.append_unique(std::move(key), read_binary(content, index, resource));
+                }
+                if (index != end)
+                    throw std::runtime_error("Invalid size of the object in the binary JSON at position: " + std::to_string(start));
+                children.sort_by_name();
+                return Json(std::move(children));
+            }
+            default:
+                throw std::runtime_error("Unknown tag in the binary JSON at position: " + std::to_string(start));
+            }
+        }
+
+        /**
+         * @brief Skip the object or array starting at index by counting the brackets among the structurals,
+         * and keep its offsets in the source to parse it on the first access
+         */
+        Json get_unresolved_object(ParseContext &context, size_t &index, bool is_object)
+        {
+            size_t start = index;
+
+            skip_container(context, index);
+            if (!context.source)
+            {
+                std::shared_ptr<const std::pmr::string> copy = std::allocate_shared<std::pmr::string>(std::pmr::polymorphic_allocator<char>(context.resource), context.str);
+                context.source = std::shared_ptr<const char>(copy, copy->data());
+            }
+            Json unresolved(is_object ? JSON_OBJECT : JSON_ARRAY, context.source, start, index + 1, context.resource);
+            unresolved.source_keys = context.options.keys;
+            unresolved.source_keep_order = context.options.keep_order;
+            index = context.scanner.next();
+            return unresolved;
+        }
+
+        /**
+         * @brief Construct an unresolved object or array, parsed on its first access
+         * from the given range of the source
+         */
+        inline Json(JsonType type, std::shared_ptr<const char> source, size_t begin, size_t end, std::pmr::memory_resource *resource) noexcept
+            : source(std::move(source)), source_begin(begin), source_end(end)
+        {
+            this->type = type;
+            if (type == JSON_ARRAY)
+                this->value.emplace<Array>(resource);
+            else
+                this->value.emplace<Object>(resource);
+            this->is_resolved = false;
+        }
+
+        inline void resolve()
+        {
+            JPP_STATS_TIMER(materialize_ns);
+            JPP_STATS_ADD(lazy_materializations, 1);
+            JPP_STATS_ADD(bytes_parsed, this->source_end - this->source_begin);
+            std::shared_ptr<const char> source = std::move(this->source);
+            std::string_view str(source.get(), this->source_end);
+            std::pmr::memory_resource *resource = this->type == JSON_ARRAY ? std::get<Array>(this->value).get_allocator().resource()
+                                                                           : std::get<Object>(this->value).get_allocator().resource();
+            ParseContext context{str, Scanner(str), resource, ParseOptions{.keep_order = this->source_keep_order, .keys = this->source_keys}, source};
+
+            context.scanner.seek(this->source_begin);
+            parse_root(context, context.scanner.next());
+        }
+
+        /**
+         * @brief The locks that serialize the resolution of lazy subtrees read through const accessors, picked by address
+         */
+        static std::mutex &lock_for(const void *key) noexcept
+        {
+            static std::mutex locks[64];
+            return locks[(reinterpret_cast<uintptr_t>(key) >> 4) % 64];
+        }
+
+        /**
+         * @brief Tell whether a memory resource can be used by several threads at the same time
+         */
+        static bool is_synchronized(std::pmr::memory_resource *resource) noexcept
+        {
+            return resource == std::pmr::new_delete_resource() || dynamic_cast<std::pmr::synchronized_pool_resource *>(resource) != nullptr;
+        }
+
+        /**
+         * @brief Resolve a lazy subtree from a const accessor, once even if several threads read it at the same time.
+         * The subtree is parsed into a separate value and published by setting is_resolved last,
+         * so readers that see it resolved see the whole subtree. Subtrees whose resource is not synchronized,
+         * like an arena, are locked by resource instead of by node, so that they are parsed one at a time
+         */
+        inline void resolve_shared() const
+        {
+            Json &self = const_cast<Json &>(*this);
+            std::atomic_ref<bool> resolved(self.is_resolved);
+
+            if (resolved.load(std::memory_order_acquire))
+                return;
+            std::mutex &node_lock = lock_for(this);
+            std::pmr::memory_resource *resource;
+            {
+                std::lock_guard<std::mutex> lock(node_lock);
+                if (resolved.load(std::memory_order_relaxed))
+                    return;
+                resource = this->type == JSON_ARRAY ? std::get<Array>(this->value).get_allocator().resource()
+                                                    : std::get<Object>(this->value).get_allocator().resource();
+            }
+            std::mutex &resource_lock = is_synchronized(resource) ? node_lock : lock_for(resource);
+            std::unique_lock<std::mutex> lock(node_lock, std::defer_lock);
+            std::unique_lock<std::mutex> allocation_lock(resource_lock, std::defer_lock);
+            if (&resource_lock == &node_lock)
+                lock.lock();
+            else
+                std::lock(lock, allocation_lock);
+            if (resolved.load(std::memory_order_relaxed))
+                return;
+
+            Json subtree(this->type, this->source, this->source_begin, this->source_end, resource);
+            subtree.source_keys = this->source_keys;
+            subtree.source_keep_order = this->source_keep_order;
+            subtree.resolve();
+            self.value = std::move(subtree.value);
+            self.source.reset();
+            resolved.store(true, std::memory_order_release);
+        }
+
+        void parse_source(std::shared_ptr<const MappedFile> file, const ParseOptions &options, std::pmr::memory_resource *resource)
+        {
+            std::string_view content = file->get_content();
+            parse_range(content, 0, std::shared_ptr<const char>(std::move(file), content.data()), options, resource);
+        }
+
+        /**
+         * @brief Parse the value starting at begin, in a string kept alive by the source
+         */
+        void parse_range(std::string_view str, size_t begin, std::shared_ptr<const char> source, const ParseOptions &options, std::pmr::memory_resource *resource)
+        {
+            JPP_STATS_TIMER(parse_ns);
+            JPP_STATS_ADD(bytes_parsed, str.length() - begin);
+            JPP_STATS_ALLOCATIONS(resource);
+            ParseContext context{str, Scanner(str), resource, options, std::move(source)};
+
+            context.scanner.seek(begin);
+            parse_root(context, context.scanner.next());
+        }
+
+        /**
+         * @brief Parse a root array on several threads. The structurals are walked once to cut the array
+         * at the separators between elements every chunk_size bytes, then the chunks are parsed concurrently
+         * and their elements moved in order into the result. Malformed input is left to the serial parser,
+         * so that the errors are the same
+         */
+        bool parse_array_parallel(ParseContext &context)
+        {
+            std::string_view str = context.str;
+            Scanner scanner = context.scanner;
+            std::pmr::vector<std::pair<size_t, size_t>> chunks(context.resource);
+            size_t index = scanner.next();
+            size_t chunk_start = index;
+            size_t chunk_size = std::max<size_t>(context.options.chunk_size, 1);
+            bool has_lazy_subtrees = false;
+            char previous = '[';
+            int level = 1;
+
+            if (index < str.length() && str[index] == ']')
+                return false;
+            while (true)
+            {
+                if (index >= str.length())
+                    return false;
+                switch (str[index])
+                {
+                case '{':
+                case '[':
+                    has_lazy_subtrees |= ++level > 2;
+                    break;
+                case '}':
+                case ']':
+                    --level;
+                    break;
+                }
+                if (level == 0)
+                {
+                    if (str[index] != ']')
+                        return false;
+                    chunks.emplace_back(chunk_start, index);
+                    break;
+                }
+                if (level == 1 && str[index] == ',' && index - chunk_start >= chunk_size)
+                {
+                    if (previous == ',')
+                        return false;
+                    chunks.emplace_back(chunk_start, index);
+                    chunk_start = scanner.next();
+                    index = chunk_start;
+                    if (index < str.length() && str[index] == ']')
+                        return false;
+                    previous = ',';
+                    continue;
+                }
+                previous = str[index];
+                index = scanner.next();
+            }
+            if (chunks.size() < 2)
+                return false;
+
+            if (has_lazy_subtrees && !context.source && !context.options.borrow_strings)
+            {
+                std::shared_ptr<const std::pmr::string> copy = std::allocate_shared<std::pmr::string>(std::pmr::polymorphic_allocator<char>(context.resource), str);
+                context.source = std::shared_ptr<const char>(copy, copy->data());
+            }
+
+            std::pmr::vector<Array> parts(context.resource);
+            std::pmr::vector<std::exception_ptr> errors(chunks.size(), context.resource);
+            std::atomic<size_t> next_chunk = 0;
+            size_t thread_count = context.options.threads > 0 ? context.options.threads : std::max(1u, std::thread::hardware_concurrency());
+
+            parts.reserve(chunks.size());
+            for (size_t i = 0; i < chunks.size(); ++i)
+                parts.emplace_back();
+
+            JPP_STATS_ADD(arrays, 1);
+            JPP_STATS_DEPTH(context.depth);
+#ifdef JPP_STATS
+            Stats *stats = Stats::current();
+            std::mutex stats_mutex;
+#endif
+            auto work = [&]()
+            {
+#ifdef JPP_STATS
+                // the workers collect their own statistics, merged into the ones of the caller when they finish
+                Stats worker_stats;
+                Stats *previous = std::exchange(Stats::current(), stats != nullptr ? &worker_stats : nullptr);
+#endif
+                size_t i;
+                while ((i = next_chunk++) < chunks.size())
+                {
+                    try
+                    {
+                        std::string_view chunk = str.substr(0, chunks[i].second);
+                        ParseContext chunk_context{chunk, Scanner(chunk), context.resource, context.options, context.source, context.depth};
+                        size_t index = chunks[i].first;
+
+                        chunk_context.scanner.seek(index);
+                        index = chunk_context.scanner.next();
+                        parse_elements(chunk_context, index, parts[i], true);
+                    }
+                    catch (...)
+                    {
+                        errors[i] = std::current_exception();
+                    }
+                }
+#ifdef JPP_STATS
+                Stats::current() = previous;
+                if (stats != nullptr)
+                {
+                    std::lock_guard lock(stats_mutex);
+                    *stats += worker_stats;
+                }
+#endif
+            };
+            {
+                // declared after the state they share, so that the started workers are joined first if starting one throws
+                std::vector<std::jthread> workers;
+                for (size_t i = 1; i < std::min(thread_count, chunks.size()); ++i)
+                    workers.emplace_back(work);
+                work();
+            }
+
+            for (std::exception_ptr &error : errors)
+                if (error)
+                    std::rethrow_exception(error);
+
+            size_t size = 0;
+            for (Array &part : parts)
+                size += part.size();
+            Array &array = this->value.emplace<Array>(context.resource);
+            array.reserve(size);
+            for (Array &part : parts)
+                std::move(part.begin(), part.end(), std::back_inserter(array));
+            return true;
+        }
+
+        void parse_root(ParseContext &context, size_t start)
+        {
+            if (start >= context.str.length())
+                throw std::runtime_error("Unexpected the end of the string");
+            this->is_resolved = true;
+            if (context.str[start] == '{')
+            {
+                this->value.emplace<Object>(parse_object(context, start));
+                this->source.reset();
+                this->type = Jpp::JSON_OBJECT;
+                return;
+            }
+            if (context.str[start] == '[')
+            {
+                if (context.options.threads == 1 || context.str.length() - start <= context.options.chunk_size || !parse_array_parallel(context))
+                    this->value.emplace<Array>(parse_array(context, start));
+                this->source.reset();
+                this->type = Jpp::JSON_ARRAY;
+                return;
+            }
+            throw std::runtime_error("Unexpected " + std::string(1, context.str[start]) + " at the beginning of the string");
+        }
+
+        inline std::string_view string_value()
+        {
+            if (RawString *str = std::get_if<RawString>(&this->value))
+                this->value.emplace<std::pmr::string>(decode_string(str->raw, str->resource));
+            if (std::string_view *str = std::get_if<std::string_view>(&this->value))
+                return *str;
+            return std::get<std::pmr::string>(this->value);
+        }
+
+        inline void assign_string(std::string_view str)
+        {
+            if (std::pmr::string *current = std::get_if<std::pmr::string>(&this->value))
+                current->assign(str);
+            else
+                this->value.emplace<std::pmr::string>(str, get_resource());
+        }
+
+        /**
+         * @brief Get the resource of the strings and containers of the value, nullptr when it allocates nothing
+         */
+        inline std::pmr::memory_resource *resource_of() const noexcept
+        {
+            switch (this->value.index())
+            {
+            case 5:
+                return std::get<std::pmr::string>(this->value).get_allocator().resource();
+            case 6:
+                return std::get<Array>(this->value).get_allocator().resource();
+            case 7:
+                return std::get<Object>(this->value).get_allocator().resource();
+            case 9:
+                return std::get<RawString>(this->value).resource;
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Move the strings and containers of the value into a resource, copying them when they are elsewhere.
+         * The empty container of a lazy subtree is only recreated, as the subtree is parsed into it when it is read
+         */
+        void adopt(std::pmr::memory_resource *resource)
+        {
+            std::pmr::memory_resource *current = resource_of();
+            if (current == nullptr || *current == *resource)
+                return;
+            if (RawString *str = std::get_if<RawString>(&this->value))
+                str->resource = resource;
+            else if (std::pmr::string *str = std::get_if<std::pmr::string>(&this->value))
+                this->value.emplace<std::pmr::string>(std::pmr::string(*str, resource));
+            else if (!this->is_resolved && this->type == JSON_ARRAY)
+                this->value.emplace<Array>(resource);
+            else if (!this->is_resolved)
+                this->value.emplace<Object>(resource, std::get<Object>(this->value).keeps_order());
+            else if (Array *array = std::get_if<Array>(&this->value))
+                this->value.emplace<Array>(Array(*array, resource));
+            else
+                this->value.emplace<Object>(Object(std::get<Object>(this->value), resource));
+        }
+
+    public:
+        /**
+         * @brief Construct a new Json object
+         * @since v1.0
+         */
+        inline Json() noexcept
+        {
+            this->type = JSON_OBJECT;
+            this->value = Object();
+            this->is_resolved = true;
+        }
+
+        /**
+         * @brief Construct a new Json object
+         *
+         * @param children
+         * @param type
+         * @since v1.0
+         */
+        inline Json(std::map<std::string, Json> children, JsonType type) noexcept
+        {
+            this->type = type;
+            this->is_resolved = true;
+            if (type != JSON_ARRAY)
+            {
+                Object object;
+                for (auto &child : children)
+                    object.emplace(std::string_view(child.first), std::move(child.second));
+                this->value = std::move(object);
+                return;
+            }
+            Array elements;
+            elements.reserve(children.size());
+            for (auto &child : children)
+                elements.push_back(std::move(child.second));
+            this->value = std::move(elements);
+        }
+
+        /**
+         * @brief Construct a new Json array
+         *
+         * @param elements
+         * @since v1.5
+         */
+        inline Json(std::vector<Json> elements)
+        {
+            this->value.emplace<Array>(std::make_move_iterator(elements.begin()), std::make_move_iterator(elements.end()));
+            this->type = JSON_ARRAY;
+            this->is_resolved = true;
+        }
+
+        /**
+         * @brief Construct a new Json array. The elements keep their memory resource
+         *
+         * @param elements
+         * @since v1.5
+         */
+        inline Json(Array elements) noexcept
+        {
+            this->value.emplace<Array>(std::move(elements));
+            this->type = JSON_ARRAY;
+            this->is_resolved = true;
+        }
+
+        /**
+         * @brief Construct a new Json object. The children keep their memory resource
+         *
+         * @param children
+         * @since v1.5
+         */
+        inline Json(Object children) noexcept
+        {
+            this->value.emplace<Object>(std::move(children));
+            this->type = JSON_OBJECT;
+            this->is_resolved = true;
+        }
+
+        /**
+         * @brief Construct a new Json object
+         *
+         * @param value
+         * @param type
+         * @since v1.0
+         */
+        inline Json(std::any value, JsonType type)
+        {
+            this->type = type;
+            this->is_resolved = true;
+            switch (type)
+            {
+            case JSON_ARRAY:
+                this->value = Array();
+                return;
+            case JSON_OBJECT:
+                this->value = Object();
+                return;
+            default:
+                *this = Json(std::move(value));
+            }
+        }
+
+        /**
+         * @brief Construct a new Json object
+         *
+         * @param values
+         * @since v1.4
+         */
+        inline Json(std::vector<std::any> values)
+        {
+            this->type = JSON_ARRAY;
+            this->is_resolved = true;
+            Array elements;
+            elements.reserve(values.size());
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                elements.emplace_back(std::move(values[i]));
+            }
+            this->value = std::move(elements);
+        }
+
+        /**
+         * @brief Construct a new Json object
+         *
+         * @param key_values
+         * @since v1.4
+         */
+        inline Json(std::vector<std::pair<std::string, std::any>> key_values)
+        {
+            this->type = JSON_OBJECT;
+            this->is_resolved = true;
+            Object children;
+            for (size_t i = 0; i < key_values.size(); ++i)
+            {
+                children.emplace(std::string_view(key_values[i].first), Json(std::move(key_values[i].second)));
+            }
+            this->value = std::move(children);
+        }
+
+        /**
+         * @brief Construct a new Json object
+         *
+         * @param value
+         * @since v1.4
+         */
+        Json(std::any value)
+        {
+            this->is_resolved = true;
+            const std::type_info &type = value.type();
+            if (type == typeid(int))
+            {
+                this->value = static_cast<int64_t>(std::any_cast<int>(value));
+                this->type = JSON_NUMBER;
+                return;
+            }
+            if (type == typeid(const char *))
+            {
+                this->value.emplace<std::pmr::string>(std::any_cast<const char *>(value));
+                this->type = JSON_STRING;
+                return;
+            }
+            if (type == typeid(std::string))
+            {
+                this->value.emplace<std::pmr::string>(std::any_cast<const std::string &>(value));
+                this->type = JSON_STRING;
+                return;
+            }
+            if (type == typeid(bool))
+            {
+                this->value = std::any_cast<bool>(value);
+                this->type = JSON_BOOLEAN;
+                return;
+            }
+            if (type == typeid(double))
+            {
+                this->value = std::any_cast<double>(value);
+                this->type = JSON_NUMBER;
+                return;
+            }
+            if (type == typeid(int64_t))
+            {
+                this->value = std::any_cast<int64_t>(value);
+                this->type = JSON_NUMBER;
+                return;
+            }
+            if (type == typeid(std::nullptr_t))
+            {
+                this->value = nullptr;
+                this->type = JSON_NULL;
+                return;
+            }
+            throw std::runtime_error("Unknown type: " + std::string(type.name()));
+        }
+
+        /**
+         * @brief Construct a new Json object
+         *
+         * @param str
+         * @since v1.0
+         */
+        inline Json(std::string str) noexcept
+        {
+            this->value.emplace<std::pmr::string>(str);
+            this->type = JSON_STRING;
+            this->is_resolved = true;
+        }
+
+        /**
+         * @brief Construct a new Json object. The string keeps its memory resource
+         *
+         * @param str
+         * @since v1.5
+         */
+        inline Json(std::pmr::string str) noexcept
+        {
+            this->value.emplace<std::pmr::string>(std::move(str));
+            this->type = JSON_STRING;
+            this->is_resolved = true;
+        }
+
+        /**
+         * @brief Construct a new Json object
+         *
+         * @param str
+         * @since v1.5
+         */
+        inline Json(const char *str)
+        {
+            this->value.emplace<std::pmr::string>(str);
+            this->type = JSON_STRING;
+            this->is_resolved = true;
+        }
+
+        /**
+         * @brief Construct a new Json object
+         *
+         * @param num
+         * @since v1.0
+         */
+        inline Json(double num) noexcept
+        {
+            this->value = num;
+            this->type = JSON_NUMBER;
+            this->is_resolved = true;
+        }
+
+        /**
+         * @brief Construct a new Json object holding an exact integer
+         *
+         * @param num
+         * @since v1.5
+         */
+        inline Json(int64_t num) noexcept
+        {
+            this->value = num;
+            this->type = JSON_NUMBER;
+            this->is_resolved = true;
+        }
+
+        /**
+         * @brief Construct a new Json object holding an exact integer
+         *
+         * @param num
+         * @since v1.5
+         */
+        inline Json(int num) noexcept : Json(static_cast<int64_t>(num))
+        {
+        }
+
+        /**
+         * @brief Construct a new Json object holding an exact unsigned integer
+         *
+         * @param num
+         * @since v1.5
+         */
+        inline Json(uint64_t num) noexcept
+        {
+            this->value = num;
+            this->type = JSON_NUMBER;
+            this->is_resolved = true;
+        }
+
+        /**
+         * @brief Construct a new Json object
+         *
+         * @param val
+         * @since v1.0
+         */
+        inline Json(bool val) noexcept
+        {
+            this->value = val;
+            this->type = JSON_BOOLEAN;
+            this->is_resolved = true;
+        }
+
+        /**
+         * @brief Construct a new Json object
+         *
+         * @param null
+         * @since v1.0
+         */
+        inline Json(std::nullptr_t null) noexcept
+        {
+            this->value = null;
+            this->type = JSON_NULL;
+            this->is_resolved = true;
+        }
+
+        Json(const Json &) = default;
+
+        /**
+         * @brief Move a JSON value. The moved containers keep their memory resource
+         *
+         * @since v1.5
+         */
+        Json(Json &&) noexcept = default;
+
+        /**
+         * @brief Copy a JSON value, allocating its strings, containers and property names from the resource of the allocator.
+         * Json is allocator-aware: the elements of a std::pmr container are copied into its resource this way
+         *
+         * @param allocator
+         * @param other
+         * @since v1.5
+         */
+        inline Json(std::allocator_arg_t, const allocator_type &allocator, const Json &other)
+            : source(other.source), source_begin(other.source_begin), source_end(other.source_end), source_keys(other.source_keys),
+              type(other.type), is_resolved(other.is_resolved), source_keep_order(other.source_keep_order)
+        {
+            std::pmr::memory_resource *resource = allocator.resource();
+            if (const std::pmr::string *str = std::get_if<std::pmr::string>(&other.value))
+                this->value.emplace<std::pmr::string>(*str, resource);
+            else if (const Array *array = std::get_if<Array>(&other.value))
+                this->value.emplace<Array>(this->is_resolved ? Array(*array, resource) : Array(resource));
+            else if (const Object *object = std::get_if<Object>(&other.value))
+                this->value.emplace<Object>(this->is_resolved ? Object(*object, resource) : Object(resource, object->keeps_order()));
+            else if (const RawString *str = std::get_if<RawString>(&other.value))
+                this->value.emplace<RawString>(RawString{str->raw, resource});
+            else
+                this->value = other.value;
+        }
+
+        inline Json(std::allocator_arg_t, const allocator_type &allocator, Json &other)
+            : Json(std::allocator_arg, allocator, std::as_const(other))
+        {
+        }
+
+        /**
+         * @brief Move a JSON value into the resource of the allocator. The value is moved when it is already there
+         * or allocates nothing, and copied otherwise
+         *
+         * @param allocator
+         * @param other
+         * @since v1.5
+         */
+        inline Json(std::allocator_arg_t, const allocator_type &allocator, Json &&other) : Json(std::move(other))
+        {
+            adopt(allocator.resource());
+        }
+
+        /**
+         * @brief Construct a JSON value from the arguments of any other constructor, in the resource of the allocator
+         *
+         * @param allocator
+         * @param args
+         * @since v1.5
+         */
+        template <typename... Args>
+        inline Json(std::allocator_arg_t, const allocator_type &allocator, Args &&...args) : Json(std::forward<Args>(args)...)
+        {
+            adopt(allocator.resource());
+        }
+
+        /**
+         * @brief Construct an empty object in a memory resource. Strings and containers assigned to it later
+         * are allocated from the same resource
+         *
+         * @param resource
+         * @since v1.5
+         */
+        inline explicit Json(std::pmr::memory_resource *resource)
+        {
+            this->value.emplace<Object>(resource);
+            this->type = JSON_OBJECT;
+            this->is_resolved = true;
+        }
+
+        ~Json() = default;
+
+        /**
+         * @brief Copy a JSON value. The value may be a subtree of this one
+         *
+         * @return Json&
+         * @since v1.0
+         */
+        inline Json &operator=(const Json &other)
+        {
+            if (this == &other)
+                return *this;
+            // other can be a child of this value, so it is copied before the current value is destroyed
+            Json copy(other);
+            return *this = std::move(copy);
+        }
+
+        /**
+         * @brief Move a JSON value. The moved containers keep their memory resource,
+         * so assigning a parsed subtree never copies it into the resource of the target
+         *
+         * @return Json&
+         * @since v1.5
+         */
+        inline Json &operator=(Json &&other) noexcept
+        {
+            if (this == &other)
+                return *this;
+            // other can be a child of this value, so it is moved out before the current value is destroyed
+            Json moved(std::move(other));
+            this->type = moved.type;
+            this->is_resolved = moved.is_resolved;
+            std::visit([this](auto &val)
+                       { this->value.emplace<std::decay_t<decltype(val)>>(std::move(val)); },
+                       moved.value);
+            this->source = std::move(moved.source);
+            this->source_begin = moved.source_begin;
+            this->source_end = moved.source_end;
+            this->source_keys = moved.source_keys;
+            this->source_keep_order = moved.source_keep_order;
+            return *this;
+        }
+
+        /**
+         * @brief Get the type object
+         *
+         * @return JsonType
+         * @since v1.0
+         */
+        inline JsonType get_type() const noexcept
+        {
+            return this->type;
+        }
+
+        /**
+         * @brief Get the memory resource of the strings and containers of the value. Numbers, booleans, null
+         * and borrowed strings allocate nothing and do not know the resource of their parent
+         *
+         * @return std::pmr::memory_resource* the default resource when the value allocates nothing
+         * @since v1.5
+         */
+        inline std::pmr::memory_resource *get_resource() const noexcept
+        {
+            std::pmr::memory_resource *resource = resource_of();
+            return resource != nullptr ? resource : std::pmr::get_default_resource();
+        }
+
+        /**
+         * @brief Get a copy of the value. Numbers are always returned as double,
+         * arrays and objects as an empty std::any. Prefer the typed accessors (as_double, as_string_view...)
+         *
+         * @return std::any
+         * @since v1.0
+         */
+        inline std::any get_value() noexcept
+        {
+            switch (this->type)
+            {
+            case JSON_NULL:
+                return nullptr;
+            case JSON_BOOLEAN:
+                return std::get<bool>(this->value);
+            case JSON_NUMBER:
+                return as_double();
+            case JSON_STRING:
+                return std::string(string_value());
+            default:
+                return std::any();
+            }
+        }
+
+        /**
+         * @brief Get the value of a number
+         *
+         * @return double
+         * @since v1.5
+         */
+        inline double as_double() const
+        {
+            if (const double *num = std::get_if<double>(&this->value))
+                return *num;
+            if (const int64_t *num = std::get_if<int64_t>(&this->value))
+                return static_cast<double>(*num);
+            if (const uint64_t *num = std::get_if<uint64_t>(&this->value))
+                return static_cast<double>(*num);
+            throw std::runtime_error("The JSON value is not a number");
+        }
+
+        /**
+         * @brief Get the value of an integer number. Fractional numbers are truncated
+         *
+         * @return int64_t
+         * @since v1.5
+         */
+        inline int64_t as_int64() const
+        {
+            if (const int64_t *num = std::get_if<int64_t>(&this->value))
+                return *num;
+            if (const double *num = std::get_if<double>(&this->value))
+                return static_cast<int64_t>(*num);
+            if (std::holds_alternative<uint64_t>(this->value))
+                throw std::out_of_range("The JSON number does not fit in an int64, use as_uint64");
+            throw std::runtime_error("The JSON value is not a number");
+        }
+
+        /**
+         * @brief Get the value of a non-negative integer number. Fractional numbers are truncated
+         *
+         * @return uint64_t
+         * @since v1.5
+         */
+        inline uint64_t as_uint64() const
+        {
+            if (const uint64_t *num = std::get_if<uint64_t>(&this->value))
+                return *num;
+            if (const int64_t *num = std::get_if<int64_t>(&this->value))
+            {
+                if (*num < 0)
+                    throw std::out_of_range("The JSON number is negative, use as_int64");
+                return static_cast<uint64_t>(*num);
+            }
+            if (const double *num = std::get_if<double>(&this->value))
+                return static_cast<uint64_t>(*num);
+            throw std::runtime_error("The JSON value is not a number");
+        }
+
+        /**
+         * @brief Check if the JSON number is stored as an exact integer
+         *
+         * @return true
+         * @return false
+         * @since v1.5
+         */
+        inline bool is_integer() const noexcept
+        {
+            return std::holds_alternative<int64_t>(this->value) || std::holds_alternative<uint64_t>(this->value);
+        }
+
+        /**
+         * @brief Get the value of a boolean
+         *
+         * @return bool
+         * @since v1.5
+         */
+        inline bool as_bool() const
+        {
+            if (const bool *val = std::get_if<bool>(&this->value))
+                return *val;
+            throw std::runtime_error("The JSON value is not a boolean");
+        }
+
+        /**
+         * @brief Get a view of the value of a string. The view is valid as long as the JSON value is not modified
+         *
+         * @return std::string_view
+         * @since v1.5
+         */
+        inline std::string_view as_string_view() const
+        {
+            if (const std::pmr::string *str = std::get_if<std::pmr::string>(&this->value))
+                return *str;
+            if (const std::string_view *str = std::get_if<std::string_view>(&this->value))
+                return *str;
+            if (this->type == JSON_STRING)
+                throw std::runtime_error("The escape sequences of the string have not been decoded yet, read it from a non-const JSON");
+            throw std::runtime_error("The JSON value is not a string");
+        }
+
+        /**
+         * @brief Get a view of the value of a string, decoding its escape sequences if it is borrowed from the parsed string.
+         * The view is valid as long as the JSON value is not modified
+         *
+         * @return std::string_view
+         * @since v1.5
+         */
+        inline std::string_view as_string_view()
+        {
+            if (this->type != JSON_STRING)
+                throw std::runtime_error("The JSON value is not a string");
+            return string_value();
+        }
+
+        /**
+         * @brief Check if the JSON value is an array
+         *
+         * @return true
+         * @return false
+         * @since v1.0
+         */
+        inline bool is_array() const noexcept
+        {
+            return this->type == JSON_ARRAY;
+        }
+
+        /**
+         * @brief Check if the JSON value is an object
+         *
+         * @return true
+         * @return false
+         * @since v1.0
+         */
+        inline bool is_object() const noexcept
+        {
+            return this->type == JSON_OBJECT;
+        }
+
+        /**
+         * @brief Check if the JSON is an atomic string value
+         *
+         * @return true
+         * @return false
+         * @since v1.0
+         */
+        inline bool is_string() const noexcept
+        {
+            return this->type == JSON_STRING;
+        }
+
+        /**
+         * @brief Check if the JSON is an atomic boolean value
+         *
+         * @return true
+         * @return false
+         * @since v1.0
+         */
+        inline bool is_boolean() const noexcept
+        {
+            return this->type == JSON_BOOLEAN;
+        }
+
+        /**
+         * @brief Check if the JSON is an atomic double value
+         *
+         * @return true
+         * @return false
+         * @since v1.0
+         */
+        inline bool is_number() const noexcept
+        {
+            return this->type == JSON_NUMBER;
+        }
+
+        /**
+         * @brief Check if the JSON is a null value
+         *
+         * @return true
+         * @return false
+         * @since v1.5
+         */
+        inline bool is_null() const noexcept
+        {
+            return this->type == JSON_NULL;
+        }
+
+        /**
+         * @brief Parse a JSON string
+         * @since v1.0
+         */
+        void parse(const std::string &json_string)
+        {
+            parse(json_string, std::pmr::get_default_resource());
+        }
+
+        /**
+         * @brief Parse a JSON string allocating every node, key and string from the given memory resource
+         *
+         * @param json_string
+         * @param resource must outlive the parsed value
+         * @since v1.5
+         */
+        void parse(std::string_view json_string, std::pmr::memory_resource *resource)
+        {
+            parse(json_string, ParseOptions(), resource);
+        }
+
+        /**
+         * @brief Parse a JSON string with the given options
+         *
+         * @param json_string
+         * @param options
+         * @param resource must outlive the parsed value
+         * @since v1.5
+         */
+        void parse(std::string_view json_string, const ParseOptions &options, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        {
+            JPP_STATS_TIMER(parse_ns);
+            JPP_STATS_ADD(bytes_parsed, json_string.length());
+            JPP_STATS_ALLOCATIONS(resource);
+            ParseContext context{json_string, Scanner(json_string), resource, options, nullptr};
+
+            parse_root(context, context.scanner.next());
+        }
+
+        /**
+         * @brief Parse a file without copying it: the file is mapped in memory, and the lazy subtrees
+         * refer to the mapping, which stays alive as long as they do
+         *
+         * @param path
+         * @param resource must outlive the parsed value
+         * @since v1.5
+         */
+        void parse_file(const std::string &path, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        {
+            parse_source(std::make_shared<const MappedFile>(path), ParseOptions(), resource);
+        }
+
+        /**
+         * @brief Parse a JSON string without building a tree: every value is reported to the handler as it is found
+         *
+         * @tparam Handler a type derived from Jpp::Handler
+         * @param json_string
+         * @param handler
+         * @param resource the memory resource of the buffer of the decoded strings
+         * @return true if the whole string was parsed, false if the handler stopped it
+         * @since v1.5
+         */
+        template <typename Handler>
+        static bool read(std::string_view json_string, Handler &handler, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        {
+            ParseContext context{json_string, Scanner(json_string), resource, ParseOptions(), nullptr};
+            std::pmr::string buffer(resource);
+            Json number(int64_t(0));
+            size_t index = context.scanner.next();
+
+            if (index >= json_string.length())
+                throw std::runtime_error("Unexpected the end of the string");
+            if (json_string[index] != '{' && json_string[index] != '[')
+                throw std::runtime_error("Unexpected " + std::string(1, json_string[index]) + " at the beginning of the string");
+            return read_value(context, index, handler, buffer, number);
+        }
+
+        /**
+         * @brief Convert a JSON number to a Json value. Integers are kept exact
+         *
+         * @param number
+         * @return Json
+         * @since v1.5
+         */
+        static Json from_number(std::string_view number)
+        {
+            Json json;
+            if (!convert_number(number, json))
+                throw std::runtime_error("Invalid number: " + std::string(number));
+            return json;
+        }
+
+        /**
+         * @brief Get a copy of the children. The elements of an array are keyed by their index.
+         * Use get_object, get_array or the iterators to read them without copying
+         *
+         * @return std::map<std::string, Json>
+         * @since v1.0
+         */
+        inline std::map<std::string, Json> get_children()
+        {
+            if (!is_resolved)
+                resolve();
+            std::map<std::string, Json> children;
+            if (this->type == JSON_OBJECT)
+            {
+                for (auto &child : std::get<Object>(this->value))
+                    children.emplace(std::string_view(child.first), child.second);
+                return children;
+            }
+            if (this->type != JSON_ARRAY)
+                return children;
+            Array &elements = std::get<Array>(this->value);
+            for (size_t i = 0; i < elements.size(); ++i)
+                children.emplace(std::to_string(i), elements[i]);
+            return children;
+        }
+
+        /**
+         * @brief Get the elements of an array without copying them
+         *
+         * @return Array&
+         * @since v1.5
+         */
+        inline Array &get_array()
+        {
+            if (this->type != JSON_ARRAY)
+                throw std::runtime_error("Cannot get the elements of a non-array JSON");
+            if (!is_resolved)
+                resolve();
+            return std::get<Array>(this->value);
+        }
+
+        /**
+         * @brief Get the properties of an object without copying them
+         * @example
+         *  for (auto &[key, value] : json.get_object())
+         *      std::cout << std::string_view(key) << ": " << value.to_string() << std::endl;
+         * @return Object&
+         * @since v1.5
+         */
+        inline Object &get_object()
+        {
+            if (this->type != JSON_OBJECT)
+                throw std::runtime_error("Cannot get the properties of a non-object JSON");
+            if (!is_resolved)
+                resolve();
+            return std::get<Object>(this->value);
+        }
+
+        /**
+         * @brief Get the elements of an array without modifying the JSON value. A lazy array is parsed once,
+         * even if several threads read it at the same time. Concurrent reads of lazy subtrees in a resource that is not
+         * synchronized, like the arena of a Document, are parsed one at a time
+         *
+         * @return const Array&
+         * @since v1.5
+         */
+        inline const Array &get_array() const
+        {
+            if (this->type != JSON_ARRAY)
+                throw std::runtime_error("Cannot get the elements of a non-array JSON");
+            resolve_shared();
+            return std::get<Array>(this->value);
+        }
+
+        /**
+         * @brief Get the properties of an object without modifying the JSON value. A lazy object is parsed once,
+         * even if several threads read it at the same time. Concurrent reads of lazy subtrees in a resource that is not
+         * synchronized, like the arena of a Document, are parsed one at a time
+         *
+         * @return const Object&
+         * @since v1.5
+         */
+        inline const Object &get_object() const
+        {
+            if (this->type != JSON_OBJECT)
+                throw std::runtime_error("Cannot get the properties of a non-object JSON");
+            resolve_shared();
+            return std::get<Object>(this->value);
+        }
+
+        /**
+         * @brief Find a property of an object without inserting it
+         *
+         * @param property
+         * @return const Json* nullptr if the object has no such property
+         * @since v1.5
+         */
+        inline const Json *find(std::string_view property) const
+        {
+            const Object &children = get_object();
+            Object::const_iterator it = children.find(property);
+            return it == children.end() ? nullptr : &it->second;
+        }
+
+        /**
+         * @brief Get a property of an object without inserting it
+         *
+         * @param property
+         * @return const Json&
+         * @throw std::out_of_range if the object has no such property
+         * @since v1.5
+         */
+        inline const Json &at(std::string_view property) const
+        {
+            return get_object().at(property);
+        }
+
+        /**
+         * @brief Get an element of an array without filling the gap up to it
+         *
+         * @param index
+         * @return const Json&
+         * @throw std::out_of_range if the index is past the end of the array
+         * @since v1.5
+         */
+        inline const Json &at(size_t index) const
+        {
+            const Array &elements = get_array();
+            if (index >= elements.size())
+                throw std::out_of_range("Index out of range: " + std::to_string(index));
+            return elements[index];
+        }
+
+        /**
+         * @brief Read a position of a const array, see at
+         *
+         * @return const Json&
+         * @since v1.5
+         */
+        inline const Json &operator[](size_t index) const
+        {
+            return at(index);
+        }
+
+        /**
+         * @brief Read a property of a const object, see at
+         *
+         * @return const Json&
+         * @since v1.5
+         */
+        inline const Json &operator[](const std::string &property) const
+        {
+            return at(std::string_view(property));
+        }
+
+        /**
+         * @brief Parse every lazy subtree and decode every borrowed string with escape sequences,
+         * after which the const accessors read the tree without modifying it
+         * @since v1.5
+         */
+        void materialize()
+        {
+            if (!is_resolved)
+                resolve();
+            if (this->type == JSON_STRING)
+                string_value();
+            else if (this->type == JSON_ARRAY)
+                for (Json &element : std::get<Array>(this->value))
+                    element.materialize();
+            else if (this->type == JSON_OBJECT)
+                for (auto &child : std::get<Object>(this->value))
+                    child.second.materialize();
+        }
+
+        /**
+         * @brief Access to a position of the array
+         * @example
+         *  Jpp::Json json;
+         *  json.parse("[0, 1, 2, 3]");
+         *  json[0] // returns an any value
+         * @note Accessing an array past its end fills the gap with null values. Growing the array
+         * never moves its elements, so references to them stay valid
+         * @return Json&
+         * @since v1.0
+         */
+        inline Json &operator[](size_t index)
+        {
+            if (this->type > Jpp::JSON_OBJECT)
+                throw std::out_of_range("Cannot use the subscript operator with an atomic value, use get_value");
+            if (!is_resolved)
+                resolve();
+            if (this->type == Jpp::JSON_OBJECT)
+                return (*this)[std::to_string(index)];
+            Array &elements = std::get<Array>(this->value);
+            if (index >= elements.size())
+                elements.resize(index + 1, Json(nullptr));
+            return elements[index];
+        }
+
+        /**
+         * @brief Access to a value of the object with the given property name
+         *
+         * @return Json&
+         * @since v1.0
+         */
+        inline Json &operator[](const std::string &property)
+        {
+            if (this->type > Jpp::JSON_OBJECT)
+                throw std::out_of_range("Cannot use the subscript operator with an atomic value, use get_value");
+            if (this->type == Jpp::JSON_ARRAY)
+                throw std::out_of_range("Cannot use a property name with an array, use an index");
+            if (!is_resolved)
+                resolve();
+            return std::get<Object>(this->value).try_emplace(property, nullptr).first->second;
+        }
+
+        /**
+         * @return Json&
+         * @since v1.0
+         */
+        inline Json &operator=(const std::string &str)
+        {
+            this->is_resolved = true;
+            this->type = Jpp::JSON_STRING;
+            assign_string(str);
+
+            return *this;
+        }
+
+        /**
+         * @return Json&
+         * @since v1.0
+         */
+        inline Json &operator=(double val)
+        {
+            this->is_resolved = true;
+            this->type = Jpp::JSON_NUMBER;
+            this->value = val;
+
+            return *this;
+        }
+
+        /**
+         * @return Json&
+         * @since v1.0
+         */
+        inline Json &operator=(int val)
+        {
+            this->is_resolved = true;
+            this->type = Jpp::JSON_NUMBER;
+            this->value = static_cast<int64_t>(val);
+
+            return *this;
+        }
+
+        /**
+         * @return Json&
+         * @since v1.5
+         */
+        inline Json &operator=(int64_t val)
+        {
+            this->is_resolved = true;
+            this->type = Jpp::JSON_NUMBER;
+            this->value = val;
+
+            return *this;
+        }
+
+        /**
+         * @return Json&
+         * @since v1.5
+         */
+        inline Json &operator=(uint64_t val)
+        {
+            this->is_resolved = true;
+            this->type = Jpp::JSON_NUMBER;
+            this->value = val;
+
+            return *this;
+        }
+
+        /**
+         * @return Json&
+         * @since v1.0
+         */
+        inline Json &operator=(bool val)
+        {
+            this->is_resolved = true;
+            this->type = Jpp::JSON_BOOLEAN;
+            this->value = val;
+
+            return *this;
+        }
+
+        /**
+         * @return Json&
+         * @since v1.0
+         */
+        inline Json &operator=(const char str[])
+        {
+            this->is_resolved = true;
+            this->type = Jpp::JSON_STRING;
+            assign_string(str);
+
+            return *this;
+        }
+
+        /**
+         * @return Json&
+         * @since v1.4
+         */
+        inline Json &operator=(std::vector<std::any> array)
+        {
+            return *this = Json(std::allocator_arg, get_resource(), std::move(array));
+        }
+
+        /**
+         * @return Json&
+         * @since v1.4
+         */
+        inline Json &operator=(std::vector<std::pair<std::string, std::any>> object)
+        {
+            return *this = Json(std::allocator_arg, get_resource(), std::move(object));
+        }
+
+        /**
+         * @return Json&
+         * @since v1.5
+         */
+        inline Json &operator=(std::vector<Json> elements)
+        {
+            return *this = Json(std::allocator_arg, get_resource(), std::move(elements));
+        }
+
+        /**
+         * @brief Replace the value with the given elements. They keep their memory resource
+         *
+         * @return Json&
+         * @since v1.5
+         */
+        inline Json &operator=(Array elements) noexcept
+        {
+            return *this = Json(std::move(elements));
+        }
+
+        /**
+         * @brief Replace the value with the given properties. They keep their memory resource
+         *
+         * @return Json&
+         * @since v1.5
+         */
+        inline Json &operator=(Object children) noexcept
+        {
+            return *this = Json(std::move(children));
+        }
+
+        /**
+         * @brief Replace the value with the given string. It keeps its memory resource
+         *
+         * @return Json&
+         * @since v1.5
+         */
+        inline Json &operator=(std::pmr::string str) noexcept
+        {
+            return *this = Json(std::move(str));
+        }
+
+        /**
+         * @brief Convert the JSON object to its JSON representation.
+         *
+         * @return std::string
+         */
+        inline std::string to_string() const
+        {
+            std::string str;
+            write(str);
+            return str;
+        }
+
+        /**
+         * @brief Write the JSON representation in a single pass. Lazy subtrees are resolved as by the const accessors,
+         * and borrowed strings with escape sequences are decoded into a temporary
+         *
+         * @param writer
+         * @since v1.5
+         */
+        void write(Writer &writer) const
+        {
+            switch (this->type)
+            {
+            case Jpp::JSON_OBJECT:
+                write_object(writer);
+                break;
+            case Jpp::JSON_ARRAY:
+                write_array(writer);
+                break;
+            case Jpp::JSON_STRING:
+                // decoded into the default resource, as the resource of the tree may be an arena shared by concurrent readers
+                if (const RawString *str = std::get_if<RawString>(&this->value))
+                    write_string(writer, decode_string(str->raw, std::pmr::get_default_resource()));
+                else
+                    write_string(writer, as_string_view());
+                break;
+            case Jpp::JSON_BOOLEAN:
+                writer.write(std::get<bool>(this->value) ? "true" : "false");
+                break;
+            case Jpp::JSON_NUMBER:
+                write_number(writer);
+                break;
+            case Jpp::JSON_NULL:
+                writer.write("null");
+                break;
+            }
+        }
+
+        /**
+         * @brief Append the JSON representation to a string
+         *
+         * @param out
+         * @since v1.5
+         */
+        inline void write(std::string &out) const
+        {
+            JPP_STATS_TIMER(serialize_ns);
+            Writer writer(out);
+            write(writer);
+            JPP_STATS_ADD(bytes_written, writer.get_written_bytes());
+        }
+
+        /**
+         * @brief Append the JSON representation to a string allocated from a memory resource
+         *
+         * @param out
+         * @since v1.5
+         */
+        inline void write(std::pmr::string &out) const
+        {
+            JPP_STATS_TIMER(serialize_ns);
+            Writer writer(out);
+            write(writer);
+            JPP_STATS_ADD(bytes_written, writer.get_written_bytes());
+        }
+
+        /**
+         * @brief Write the JSON representation to a stream
+         *
+         * @param out
+         * @since v1.5
+         */
+        inline void write(std::ostream &out) const
+        {
+            JPP_STATS_TIMER(serialize_ns);
+            Writer writer(out);
+            write(writer);
+            JPP_STATS_ADD(bytes_written, writer.get_written_bytes());
+        }
+
+        /**
+         * @brief Write the JSON representation to a file descriptor
+         *
+         * @param fd
+         * @since v1.5
+         */
+        inline void write(int fd) const
+        {
+            JPP_STATS_TIMER(serialize_ns);
+            Writer writer(fd);
+            write(writer);
+            JPP_STATS_ADD(bytes_written, writer.get_written_bytes());
+        }
+
+        /**
+         * @brief Encode the value in the binary format of Jpp, which is decoded without tokenizing.
+         * The encoding starts with the header "Jpp" and the version byte 1, followed by the value.
+         * Every value starts with a tag byte: 0 null, 1 false, 2 true, 3 integer as a zigzag varint,
+         * 4 unsigned integer as a varint, 5 double as 8 little-endian bytes, 6 string as a varint length and the UTF-8 bytes.
+         * Arrays (7), objects sorted by name (8) and objects in insertion order (9) continue with the size in bytes
+         * of the rest of the container as 4 little-endian bytes, so that it can be skipped, and the varint number of children.
+         * The properties of an object are a varint name length, the name and the value
+         *
+         * @return std::string
+         * @since v1.5
+         */
+        inline std::string to_binary()
+        {
+            std::string out(binary_header);
+            write_binary(out);
+            return out;
+        }
+
+        /**
+         * @brief Decode a value encoded with to_binary
+         *
+         * @param data
+         * @param resource must outlive the decoded value
+         * @return Json
+         * @throw std::runtime_error if the data is not a valid binary JSON
+         * @since v1.5
+         */
+        static Json from_binary(std::string_view data, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        {
+            if (!data.starts_with(binary_header))
+                throw std::runtime_error("The data is not a binary JSON of this version");
+            size_t index = binary_header.length();
+            Json json = read_binary(data, index, resource);
+            if (index != data.length())
+                throw std::runtime_error("Unexpected data after the binary JSON at position: " + std::to_string(index));
+            return json;
+        }
+
+        /**
+         * @brief Bidirectional iterator over the children of an object or the elements of an array.
+         * Dereferencing yields the property name and the value; the name is empty for array elements
+         * @since v1.5
+         */
+        class Iterator
+        {
+        private:
+            friend class Json;
+
+            bool is_array;
+            Object::iterator child;
+            Array::iterator element;
+
+        public:
+            using iterator_category = std::bidirectional_iterator_tag;
+            using value_type = std::pair<std::string_view, Json &>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = value_type;
+
+            Iterator() = default;
+
+            inline value_type operator*() const
+            {
+                if (is_array)
+                    return value_type(std::string_view(), *element);
+                return value_type(child->first, child->second);
+            }
+
+            inline Iterator &operator++() noexcept
+            {
+                if (is_array)
+                    ++element;
+                else
+                    ++child;
+                return *this;
+            }
+
+            inline Iterator operator++(int) noexcept
+            {
+                Iterator it = *this;
+                ++*this;
+                return it;
+            }
+
+            inline Iterator &operator--() noexcept
+            {
+                if (is_array)
+                    --element;
+                else
+                    --child;
+                return *this;
+            }
+
+            inline Iterator operator--(int) noexcept
+            {
+                Iterator it = *this;
+                --*this;
+                return it;
+            }
+
+            inline bool operator==(const Iterator &other) const noexcept
+            {
+                return is_array ? element == other.element : child == other.child;
+            }
+
+            inline bool operator!=(const Iterator &other) const noexcept
+            {
+                return !(*this == other);
+            }
+        };
+
+        /**
+         * @brief Begin iterator. Arrays are walked in index order
+         *
+         * @return Iterator
+         * @since v1.1
+         */
+        inline Iterator begin()
+        {
+            if (!is_resolved)
+                resolve();
+            Iterator it;
+            it.is_array = this->type == JSON_ARRAY;
+            if (it.is_array)
+                it.element = std::get<Array>(this->value).begin();
+            else if (this->type == JSON_OBJECT)
+                it.child = std::get<Object>(this->value).begin();
+            return it;
+        }
+
+        /**
+         * @brief End iterator
+         *
+         * @return Iterator
+         * @since v1.1
+         */
+        inline Iterator end()
+        {
+            if (!is_resolved)
+                resolve();
+            Iterator it;
+            it.is_array = this->type == JSON_ARRAY;
+            if (it.is_array)
+                it.element = std::get<Array>(this->value).end();
+            else if (this->type == JSON_OBJECT)
+                it.child = std::get<Object>(this->value).end();
+            return it;
+        }
+
+        /**
+         * @brief Reverse begin iterator
+         *
+         * @return std::reverse_iterator<Iterator>
+         * @since v1.1
+         */
+        inline std::reverse_iterator<Iterator> rbegin()
+        {
+            return std::reverse_iterator<Iterator>(end());
+        }
+
+        /**
+         * @brief Reverse end iterator
+         *
+         * @return std::reverse_iterator<Iterator>
+         * @since v1.1
+         */
+        inline std::reverse_iterator<Iterator> rend()
+        {
+            return std::reverse_iterator<Iterator>(begin());
+        }
+
+        /**
+         * @brief Get the number of elements of an array or the number of properties of an object
+         *
+         * @return size_t
+         * @since v1.5
+         */
+        inline size_t size()
+        {
+            if (!is_resolved)
+                resolve();
+            if (this->type == JSON_ARRAY)
+                return std::get<Array>(this->value).size();
+            if (this->type == JSON_OBJECT)
+                return std::get<Object>(this->value).size();
+            return 0;
+        }
+
+        /**
+         * @brief Get the number of elements of an array or the number of properties of an object without modifying the JSON value
+         *
+         * @return size_t
+         * @since v1.5
+         */
+        inline size_t size() const
+        {
+            if (this->type == JSON_ARRAY)
+                return get_array().size();
+            if (this->type == JSON_OBJECT)
+                return get_object().size();
+            return 0;
+        }
+
+        /**
+         * @brief Reserve space for the given number of elements of an array
+         *
+         * @param capacity
+         * @since v1.5
+         */
+        inline void reserve(size_t capacity)
+        {
+            if (this->type != JSON_ARRAY)
+                throw std::runtime_error("Cannot reserve space in a non-array JSON");
+            if (!is_resolved)
+                resolve();
+            std::get<Array>(this->value).reserve(capacity);
+        }
+
+        /**
+         * @brief Append a value at the end of an array. It is moved into the memory resource of the array,
+         * or copied when it was allocated from another one
+         *
+         * @param value
+         * @since v1.5
+         */
+        inline void push_back(Json value)
+        {
+            if (this->type != JSON_ARRAY)
+                throw std::runtime_error("Cannot push a value into a non-array JSON");
+            if (!is_resolved)
+                resolve();
+            std::get<Array>(this->value).push_back(std::move(value));
+        }
+
+        /**
+         * @brief Get a copy of the elements if the JSON object is an array. Use get_array to read them without copying
+         *
+         * @return std::vector<Json>
+         * @since v1.2
+         */
+        inline std::vector<Json> get_vector()
+        {
+            if (type != JSON_ARRAY)
+                throw std::runtime_error("Cannot convert a non-array JSON to a vector");
+            if (!is_resolved)
+                resolve();
+            Array &elements = std::get<Array>(this->value);
+            return std::vector<Json>(elements.begin(), elements.end());
+        }
+    };
+
+    // containers of Json relocate their elements with moves only if the moves cannot throw
+    static_assert(std::is_nothrow_move_constructible_v<Json> && std::is_nothrow_move_assignable_v<Json>);
+
+    /**
+     * @brief A compiled query that selects values of a JSON document. It is either a JSON Pointer, such as
+     * "/quiz/maths/q1/answer", or a JSONPath made of "$", ".name", "['name']", "[index]" with negative indices
+     * counting from the end, "[start:end:step]" slices and the "*" wildcard. Compile a path once and evaluate it many times:
+     * on a string, the values that do not match are skipped by counting brackets and only the matches are parsed
+     * @example
+     *  Jpp::Path answers("$.quiz.*.q1.answer");
+     *  for (Jpp::Json &answer : answers.evaluate(json_string))
+     *      std::cout << answer.as_string_view() << std::endl;
+     * @since v1.5
+     */
+    class Path
+    {
+    private:
+        enum StepType
+        {
+            STEP_NAME,
+            STEP_INDEX,
+            STEP_WILDCARD,
+            STEP_SLICE
+        };
+
+        /**
+         * @brief A level of the path. The tokens of a JSON Pointer that are array indices also select elements
+         */
+        struct Step
+        {
+            StepType type;
+            std::string name = {};
+            size_t hash = 0;
+            int64_t index = -1;
+            int64_t start = 0;
+            int64_t end = 0;
+            int64_t step = 1;
+            bool has_start = false;
+            bool has_end = false;
+        };
+
+        std::string expression;
+        std::vector<Step> steps;
+
+        void add_name(std::string name, bool is_pointer)
+        {
+            Step step{.type = STEP_NAME, .name = std::move(name)};
+
+            step.hash = Key::hash_of(step.name);
+            if (is_pointer && !step.name.empty() && (step.name[0] != '0' || step.name.length() == 1))
+            {
+                const char *last = step.name.data() + step.name.length();
+                int64_t index;
+                std::from_chars_result result = std::from_chars(step.name.data(), last, index);
+                if (result.ec == std::errc() && result.ptr == last && index >= 0)
+                    step.index = index;
+            }
+            this->steps.push_back(std::move(step));
+        }
+
+        void compile_pointer(std::string_view str)
+        {
+            size_t index = 0;
+
+            while (index < str.length())
+            {
+                size_t end = std::min(str.find('/', index + 1), str.length());
+                std::string token;
+                for (size_t i = index + 1; i < end; ++i)
+                {
+                    if (str[i] != '~')
+                        token += str[i];
+                    else if (i + 1 < end && (str[i + 1] == '0' || str[i + 1] == '1'))
+                        token += str[++i] == '0' ? '~' : '/';
+                    else
+                        throw std::invalid_argument("Invalid escape sequence in the JSON Pointer at position: " + std::to_string(i));
+                }
+                add_name(std::move(token), true);
+                index = end;
+            }
+        }
+
+        static int64_t to_integer(std::string_view str, size_t position)
+        {
+            const char *last = str.data() + str.length();
+            int64_t integer;
+            std::from_chars_result result = std::from_chars(str.data(), last, integer);
+
+            if (str.empty() || result.ec != std::errc() || result.ptr != last)
+                throw std::invalid_argument("Invalid index: " + std::string(str) + " at position: " + std::to_string(position));
+            return integer;
+        }
+
+        void compile_selector(std::string_view selector, size_t position)
+        {
+            Step step{.type = STEP_INDEX};
+            size_t colon = selector.find(':');
+
+            if (selector == "*")
+            {
+                this->steps.push_back(Step{.type = STEP_WILDCARD});
+                return;
+            }
+            if (colon == std::string_view::npos)
+            {
+                step.index = to_integer(selector, position);
+                this->steps.push_back(std::move(step));
+                return;
+            }
+
+            std::string_view rest = selector.substr(colon + 1);
+            size_t second = rest.find(':');
+            std::string_view end = rest.substr(0, second);
+
+            step.type = STEP_SLICE;
+            step.has_start = colon > 0;
+            step.has_end = !end.empty();
+            if (step.has_start)
+                step.start = to_integer(selector.substr(0, colon), position);
+            if (step.has_end)
+                step.end = to_integer(end, position + colon + 1);
+            if (second != std::string_view::npos && second + 1 < rest.length())
+                step.step = to_integer(rest.substr(second + 1), position + colon + second + 2);
+            if (step.step <= 0)
+                throw std::invalid_argument("The step of a slice must be positive at position: " + std::to_string(position));
+            this->steps.push_back(std::move(step));
+        }
+
+        void compile_json_path(std::string_view str)
+        {
+            size_t index = 1;
+
+            while (index < str.length())
+            {
+                if (str[index] == '.')
+                {
+                    size_t start = ++index;
+                    while (index < str.length() && str[index] != '.' && str[index] != '[')
+                        ++index;
+                    std::string_view name = str.substr(start, index - start);
+                    if (name.empty())
+                        throw std::invalid_argument("Expected a property name at position: " + std::to_string(start));
+                    if (name == "*")
+                        this->steps.push_back(Step{.type = STEP_WILDCARD});
+                    else
+                        add_name(std::string(name), false);
+                    continue;
+                }
+                if (str[index] != '[')
+                    throw std::invalid_argument("Expected '.' or '[' at position: " + std::to_string(index));
+
+                ++index;
+                if (index < str.length() && (str[index] == '\'' || str[index] == '"'))
+                {
+                    char quote = str[index];
+                    std::string name;
+                    size_t i = index + 1;
+                    for (; i < str.length() && str[i] != quote; ++i)
+                    {
+                        if (str[i] == '\\' && i + 1 < str.length())
+                            ++i;
+                        name += str[i];
+                    }
+                    if (i + 1 >= str.length() || str[i + 1] != ']')
+                        throw std::invalid_argument("Expected the end of the property name at position: " + std::to_string(i));
+                    add_name(std::move(name), false);
+                    index = i + 2;
+                    continue;
+                }
+
+                size_t close = str.find(']', index);
+                if (close == std::string_view::npos)
+                    throw std::invalid_argument("Expected ']' after position: " + std::to_string(index));
+                compile_selector(str.substr(index, close - index), index);
+                index = close + 1;
+            }
+        }
+
+        static inline bool needs_length(const Step &step) noexcept
+        {
+            return (step.type == STEP_INDEX && step.index < 0) ||
+                   (step.type == STEP_SLICE && ((step.has_start && step.start < 0) || (step.has_end && step.end < 0)));
+        }
+
+        /**
+         * @brief Get the range of the indices that a step can select in an array of the given length
+         */
+        static void get_bounds(const Step &step, int64_t length, int64_t &first, int64_t &last) noexcept
+        {
+            auto clamp = [length](int64_t position)
+            { return position < 0 ? std::max<int64_t>(position + length, 0) : std::min(position, length); };
+
+            switch (step.type)
+            {
+            case STEP_NAME:
+            case STEP_INDEX:
+                first = step.index < 0 && step.type == STEP_INDEX ? step.index + length : step.index;
+                last = first < 0 ? first : first + 1;
+                break;
+            case STEP_WILDCARD:
+                first = 0;
+                last = length;
+                break;
+            case STEP_SLICE:
+                first = step.has_start ? clamp(step.start) : 0;
+                last = step.has_end ? clamp(step.end) : length;
+                break;
+            }
+        }
+
+        static inline bool selects(const Step &step, int64_t position, int64_t first, int64_t last) noexcept
+        {
+            return position >= first && position < last && (position - first) % step.step == 0;
+        }
+
+        /**
+         * @brief Count the elements of the array starting at index, leaving the scan where it is
+         */
+        static int64_t count_elements(const Json::ParseContext &context, size_t index)
+        {
+            Scanner scanner = context.scanner;
+            std::string_view str = context.str;
+            int64_t count = 0;
+            int level = 1;
+
+            index = scanner.next();
+            if (index < str.length() && str[index] == ']')
+                return 0;
+            while (level > 0)
+            {
+                if (index >= str.length())
+                    throw std::runtime_error("Unexpected end of the string");
+                switch (str[index])
+                {
+                case '{':
+                case '[':
+                    level++;
+                    break;
+                case '}':
+                case ']':
+                    level--;
+                    break;
+                case ',':
+                    count += level == 1;
+                    break;
+                }
+                index = scanner.next();
+            }
+            return count + 1;
+        }
+
+        void match_object(Json::ParseContext &context, size_t &index, size_t depth, std::vector<Json> &results) const
+        {
+            const Step &step = this->steps[depth];
+            std::string_view str = context.str;
+            bool found = false;
+
+            index = context.scanner.next();
+            if (Json::match_next(str, index) == Jpp::Token::OBJECT_END)
+            {
+                index = context.scanner.next();
+                return;
+            }
+            while (true)
+            {
+                if (Json::match_next(str, index) != Jpp::Token::STRING)
+                    throw std::runtime_error("Expected a property name at position: " + std::to_string(index));
+                bool has_escapes;
+                std::string_view name = Json::scan_string(context, index, has_escapes);
+                if (index >= str.length() || str[index] != ':')
+                    throw std::runtime_error("Expected ':' at position: " + std::to_string(index));
+                index = context.scanner.next();
+
+                bool selected = step.type == STEP_WILDCARD;
+                if (!selected && !found)
+                {
+                    if (has_escapes)
+                        selected = std::string_view(Json::decode_string(name, context.resource)) == step.name;
+                    else
+                        selected = name == step.name;
+                    found = selected;
+                }
+                if (selected)
+                    match(context, index, depth + 1, results);
+                else
+                    Json::skip_value(context, index);
+
+                Jpp::Token next = Json::match_next(str, index);
+                if (next != Jpp::Token::SEPARATOR && next != Jpp::Token::OBJECT_END)
+                    throw std::runtime_error("Expected a ',' or the end of the object at position: " + std::to_string(index));
+                index = context.scanner.next();
+                if (next == Jpp::Token::OBJECT_END)
+                    return;
+            }
+        }
+
+        void match_array(Json::ParseContext &context, size_t &index, size_t depth, std::vector<Json> &results) const
+        {
+            const Step &step = this->steps[depth];
+            std::string_view str = context.str;
+            int64_t length = needs_length(step) ? count_elements(context, index) : std::numeric_limits<int64_t>::max();
+            int64_t first = 0;
+            int64_t last = 0;
+
+            get_bounds(step, length, first, last);
+            index = context.scanner.next();
+            if (Json::match_next(str, index) == Jpp::Token::ARRAY_END)
+            {
+                index = context.scanner.next();
+                return;
+            }
+            for (int64_t position = 0;; ++position)
+            {
+                if (selects(step, position, first, last))
+                    match(context, index, depth + 1, results);
+                else
+                    Json::skip_value(context, index);
+
+                Jpp::Token next = Json::match_next(str, index);
+                if (next != Jpp::Token::SEPARATOR && next != Jpp::Token::ARRAY_END)
+                    throw std::runtime_error("Expected a ',' or the end of the array at position: " + std::to_string(index));
+                index = context.scanner.next();
+                if (next == Jpp::Token::ARRAY_END)
+                    return;
+            }
+        }
+
+        void match(Json::ParseContext &context, size_t &index, size_t depth, std::vector<Json> &results) const
+        {
+            if (depth == this->steps.size())
+            {
+                results.push_back(Json::parse_value(context, index));
+                return;
+            }
+
+            const Step &step = this->steps[depth];
+            Jpp::Token token = Json::match_next(context.str, index);
+            if (token == Jpp::Token::OBJECT_START && (step.type == STEP_NAME || step.type == STEP_WILDCARD))
+                match_object(context, index, depth, results);
+            else if (token == Jpp::Token::ARRAY_START && (step.type != STEP_NAME || step.index >= 0))
+                match_array(context, index, depth, results);
+            else
+                Json::skip_value(context, index);
+        }
+
+        void select(Json &json, size_t depth, std::vector<Json *> &results) const
+        {
+            if (depth == this->steps.size())
+            {
+                results.push_back(&json);
+                return;
+            }
+
+            const Step &step = this->steps[depth];
+            if (json.is_object() && step.type == STEP_WILDCARD)
+            {
+                for (auto &property : json.get_object())
+                    select(property.second, depth + 1, results);
+            }
+            else if (json.is_object() && step.type == STEP_NAME)
+            {
+                Json::Object &object = json.get_object();
+                Json::Object::iterator it = object.find(step.name, step.hash);
+                if (it != object.end())
+                    select(it->second, depth + 1, results);
+            }
+            else if (json.is_array())
+            {
+                Json::Array &elements = json.get_array();
+                int64_t first = 0;
+                int64_t last = 0;
+                get_bounds(step, static_cast<int64_t>(elements.size()), first, last);
+                last = std::min(last, static_cast<int64_t>(elements.size()));
+                for (int64_t position = std::max<int64_t>(first, 0); position < last; position += step.step)
+                    select(elements[position], depth + 1, results);
+            }
+        }
+
+    public:
+        /**
+         * @brief Compile a JSON Pointer, which is empty or starts with '/', or a JSONPath, which starts with '$'
+         *
+         * @param expression
+         * @throw std::invalid_argument if the expression is not a valid path
+         * @since v1.5
+         */
+        explicit Path(std::string_view expression) : expression(expression)
+        {
+            if (expression.empty() || expression[0] == '/')
+                compile_pointer(expression);
+            else if (expression[0] == '$')
+                compile_json_path(expression);
+            else
+                throw std::invalid_argument("A path starts with '/' or '$': " + std::string(expression));
+        }
+
+        /**
+         * @brief Get the expression the path was compiled from
+         *
+         * @return const std::string&
+         * @since v1.5
+         */
+        inline const std::string &get_expression() const noexcept
+        {
+            return this->expression;
+        }
+
+        /**
+         * @brief Find the values matched by the path in a JSON string, in the order of the string.
+         * Only the matched values are parsed, with the given options
+         *
+         * @param json_string
+         * @param options
+         * @param resource must outlive the returned values
+         * @return std::vector<Json>
+         * @since v1.5
+         */
+        std::vector<Json> evaluate(std::string_view json_string, const ParseOptions &options = ParseOptions(),
+                                   std::pmr::memory_resource *resource = std::pmr::get_default_resource()) const
+        {
+            Json::ParseContext context{json_string, Scanner(json_string), resource, options, nullptr};
+            std::vector<Json> results;
+            size_t index = context.scanner.next();
+
+            if (index >= json_string.length())
+                throw std::runtime_error("Unexpected the end of the string");
+            match(context, index, 0, results);
+            return results;
+        }
+
+        /**
+         * @brief Find the values matched by the path in a parsed tree. Only the lazy subtrees along the path are resolved
+         *
+         * @param json
+         * @return std::vector<Json *> the matched values, which stay valid as long as the tree is not modified
+         * @since v1.5
+         */
+        std::vector<Json *> select(Json &json) const
+        {
+            std::vector<Json *> results;
+            select(json, 0, results);
+            return results;
+        }
+
+        /**
+         * @brief Find the first value matched by the path in a parsed tree
+         *
+         * @param json
+         * @return Json* nullptr if nothing matches
+         * @since v1.5
+         */
+        Json *find(Json &json) const
+        {
+            std::vector<Json *> results = select(json);
+            return results.empty() ? nullptr : results.front();
+        }
+    };
+
+    /**
+     * @brief The members of a struct bound to the properties of a JSON object. Specialize it with JPP_FIELDS
+     * @since v1.5
+     */
+    template <typename T>
+    struct Fields;
+
+    /**
+     * @brief Decode JSON strings directly into C++ types and encode them back, without building a Json tree.
+     * Supported types are bool, arithmetic types, std::string, std::optional, std::vector, Json
+     * and the structs bound with JPP_FIELDS. The property names of a struct and their hashes are computed at compile time,
+     * properties without a member are skipped and members without a property keep their value
+     * @example
+     *  Person person = Jpp::Binder::decode<Person>(json_string);
+     *  std::string json_string = Jpp::Binder::encode(person);
+     * @since v1.5
+     */
+    class Binder
+    {
+    private:
+        template <typename T>
+        struct is_vector : std::false_type
+        {
+        };
+
+        template <typename T, typename Allocator>
+        struct is_vector<std::vector<T, Allocator>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        struct is_optional : std::false_type
+        {
+        };
+
+        template <typename T>
+        struct is_optional<std::optional<T>> : std::true_type
+        {
+        };
+
+        template <typename T>
+        static constexpr bool has_fields = requires { Fields<T>::fields; };
+
+        template <typename T>
+        static constexpr bool is_bindable = false;
+
+        static std::runtime_error expected(std::string_view what, size_t index)
+        {
+            return std::runtime_error("Expected " + std::string(what) + " at position: " + std::to_string(index));
+        }
+
+        template <typename T, size_t... I>
+        static bool read_field(Json::ParseContext &context, size_t &index, T &out, std::string_view name, std::string &buffer, std::index_sequence<I...>)
+        {
+            constexpr auto &fields = Fields<T>::fields;
+            uint64_t hash = hash_name(name);
+
+            return ((hash == std::get<I>(fields).hash && name == std::get<I>(fields).name &&
+                     (read(context, index, out.*(std::get<I>(fields).member), buffer), true)) ||
+                    ...);
+        }
+
+        template <typename T>
+        static void read_object(Json::ParseContext &context, size_t &index, T &out, std::string &buffer)
+        {
+            std::string_view str = context.str;
+            constexpr size_t count = std::tuple_size_v<std::decay_t<decltype(Fields<T>::fields)>>;
+
+            index = context.scanner.next();
+            if (Json::match_next(str, index) == Jpp::Token::OBJECT_END)
+            {
+                index = context.scanner.next();
+                return;
+            }
+            while (true)
+            {
+                if (Json::match_next(str, index) != Jpp::Token::STRING)
+                    throw expected("a property name", index);
+                bool has_escapes;
+                std::string_view name = Json::scan_string(context, index, has_escapes);
+                if (has_escapes)
+                {
+                    buffer.clear();
+                    Json::append_decoded(name, buffer);
+                    name = buffer;
+                }
+                if (index >= str.length() || str[index] != ':')
+                    throw expected("':'", index);
+                index = context.scanner.next();
+
+                if (!read_field(context, index, out, name, buffer, std::make_index_sequence<count>()))
+                    Json::skip_value(context, index);
+
+                Jpp::Token next = Json::match_next(str, index);
+                if (next != Jpp::Token::SEPARATOR && next != Jpp::Token::OBJECT_END)
+                    throw expected("a ',' or the end of the object", index);
+                index = context.scanner.next();
+                if (next == Jpp::Token::OBJECT_END)
+                    return;
+            }
+        }
+
+        template <typename T>
+        static void read(Json::ParseContext &context, size_t &index, T &out, std::string &buffer)
+        {
+            std::string_view str = context.str;
+            Jpp::Token token = Json::match_next(str, index);
+
+            if constexpr (std::is_same_v<T, Json>)
+                out = Json::parse_value(context, index);
+            else if constexpr (is_optional<T>::value)
+            {
+                if (token == Jpp::Token::ALPHA && str[index] == 'n')
+                {
+                    Json::parse_null(context, index);
+                    out.reset();
+                }
+                else
+                    read(context, index, out.emplace(), buffer);
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+            {
+                if (token != Jpp::Token::ALPHA)
+                    throw expected("a boolean", index);
+                out = Json::parse_boolean(context, index);
+            }
+            else if constexpr (std::is_arithmetic_v<T>)
+            {
+                if (token != Jpp::Token::NUMBER)
+                    throw expected("a number", index);
+                size_t start = index;
+                std::string_view number = Json::scan_token(context, index);
+                const char *last = number.data() + number.length();
+                std::from_chars_result result = std::from_chars(number.data(), last, out);
+                if (result.ec != std::errc() || result.ptr != last)
+                    throw std::runtime_error("Invalid number: " + std::string(number) + " at position: " + std::to_string(start));
+            }
+            else if constexpr (std::is_same_v<T, std::string>)
+            {
+                if (token != Jpp::Token::STRING)
+                    throw expected("a string", index);
+                bool has_escapes;
+                std::string_view raw = Json::scan_string(context, index, has_escapes);
+                out.clear();
+                if (has_escapes)
+                    Json::append_decoded(raw, out);
+                else
+                    out.assign(raw);
+            }
+            else if constexpr (is_vector<T>::value)
+            {
+                if (token != Jpp::Token::ARRAY_START)
+                    throw expected("an array", index);
+                out.clear();
+                index = context.scanner.next();
+                if (Json::match_next(str, index) == Jpp::Token::ARRAY_END)
+                {
+                    index = context.scanner.next();
+                    return;
+                }
+                while (true)
+                {
+                    read(context, index, out.emplace_back(), buffer);
+                    Jpp::Token next = Json::match_next(str, index);
+                    if (next != Jpp::Token::SEPARATOR && next != Jpp::Token::ARRAY_END)
+                        throw expected("a ',' or the end of the array", index);
+                    index = context.scanner.next();
+                    if (next == Jpp::Token::ARRAY_END)
+                        return;
+                }
+            }
+            else if constexpr (has_fields<T>)
+            {
+                if (token != Jpp::Token::OBJECT_START)
+                    throw expected("an object", index);
+                read_object(context, index, out, buffer);
+            }
+            else
+                static_assert(is_bindable<T>, "The type cannot be bound to JSON, list its members with JPP_FIELDS");
+        }
+
+        template <typename T, typename Field>
+        static void write_field(Writer &writer, const T &value, const Field &field, bool first)
+        {
+            if (!first)
+                writer.write(", ");
+            writer.put('"');
+            writer.write(field.name);
+            writer.write("\":");
+            write(writer, value.*(field.member));
+        }
+
+        template <typename T, size_t... I>
+        static void write_object(Writer &writer, const T &value, std::index_sequence<I...>)
+        {
+            constexpr auto &fields = Fields<T>::fields;
+
+            writer.put('{');
+            (write_field(writer, value, std::get<I>(fields), I == 0), ...);
+            writer.put('}');
+        }
+
+        template <typename T>
+        static void write(Writer &writer, const T &value)
+        {
+            if constexpr (std::is_same_v<T, Json>)
+                value.write(writer);
+            else if constexpr (is_optional<T>::value)
+            {
+                if (value.has_value())
+                    write(writer, *value);
+                else
+                    writer.write("null");
+            }
+            else if constexpr (std::is_same_v<T, bool>)
+                writer.write(value ? "true" : "false");
+            else if constexpr (std::is_integral_v<T>)
+            {
+                char buffer[32];
+                std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+                writer.write(std::string_view(buffer, static_cast<size_t>(result.ptr - buffer)));
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+                Json(static_cast<double>(value)).write(writer);
+            else if constexpr (std::is_same_v<T, std::string>)
+                Json::write_string(writer, value);
+            else if constexpr (is_vector<T>::value)
+            {
+                writer.put('[');
+                for (size_t i = 0; i < value.size(); ++i)
+                {
+                    if (i > 0)
+                        writer.put(',');
+                    write(writer, value[i]);
+                }
+                writer.put(']');
+            }
+            else if constexpr (has_fields<T>)
+                write_object(writer, value, std::make_index_sequence<std::tuple_size_v<std::decay_t<decltype(Fields<T>::fields)>>>());
+            else
+                static_assert(is_bindable<T>, "The type cannot be bound to JSON, list its members with JPP_FIELDS");
+        }
+
+    public:
+        /**
+         * @brief The hash of a property name used to match the properties with the members, FNV-1a
+         *
+         * @param name
+         * @return uint64_t
+         * @since v1.5
+         */
+        static constexpr uint64_t hash_name(std::string_view name) noexcept
+        {
+            uint64_t hash = 0xcbf29ce484222325ULL;
+            for (char ch : name)
+                hash = (hash ^ static_cast<unsigned char>(ch)) * 0x100000001b3ULL;
+            return hash;
+        }
+
+        /**
+         * @brief Decode a JSON string into an existing value, reusing its memory
+         *
+         * @tparam T
+         * @param json_string
+         * @param out
+         * @since v1.5
+         */
+        template <typename T>
+        static void decode(std::string_view json_string, T &out)
+        {
+            Json::ParseContext context{json_string, Scanner(json_string), std::pmr::get_default_resource(), ParseOptions(), nullptr};
+            std::string buffer;
+            size_t index = context.scanner.next();
+
+            if (index >= json_string.length())
+                throw std::runtime_error("Unexpected the end of the string");
+            read(context, index, out, buffer);
+        }
+
+        /**
+         * @brief Decode a JSON string into a new value
+         *
+         * @tparam T a default constructible type
+         * @param json_string
+         * @return T
+         * @since v1.5
+         */
+        template <typename T>
+        static T decode(std::string_view json_string)
+        {
+            T out{};
+            decode(json_string, out);
+            return out;
+        }
+
+        /**
+         * @brief Write the JSON representation of a value
+         *
+         * @tparam T
+         * @param value
+         * @param writer
+         * @since v1.5
+         */
+        template <typename T>
+        static void encode(const T &value, Writer &writer)
+        {
+            write(writer, value);
+        }
+
+        /**
+         * @brief Get the JSON representation of a value
+         *
+         * @tparam T
+         * @param value
+         * @return std::string
+         * @since v1.5
+         */
+        template <typename T>
+        static std::string encode(const T &value)
+        {
+            std::string str;
+            {
+                Writer writer(str);
+                write(writer, value);
+            }
+            return str;
+        }
+    };
+
+    /**
+     * @brief A member of a struct bound with JPP_FIELDS
+     * @since v1.5
+     */
+    template <typename Class, typename Member>
+    struct Field
+    {
+        std::string_view name;
+        Member Class::*member;
+        uint64_t hash;
+    };
+
+    template <typename Class, typename Member>
+    constexpr Field<Class, Member> make_field(std::string_view name, Member Class::*member) noexcept
+    {
+        return Field<Class, Member>{name, member, Binder::hash_name(name)};
+    }
+
+    /**
+     * @brief A parsed JSON document that owns the memory of its tree.
+     * Every node, key and string is taken from a monotonic arena that is released at once
+     * when the document is parsed again or destroyed, so the values of the document must not outlive it.
+     * The chunks of the arena are kept between parses, so parsing documents of the same shape again
+     * does not allocate from the heap
+     * @example
+     *  Jpp::Document doc;
+     *  Jpp::Json &root = doc.parse(json_string);
+     *  doc.get_allocation_count() // number of arena chunks requested to the heap
+     * @since v1.5
+     */
+    class Document
+    {
+    private:
+        CountingResource upstream;
+        RecyclingResource chunks;
+        std::pmr::monotonic_buffer_resource arena;
+        std::shared_ptr<const MappedFile> file;
+        Json root;
+
+        /**
+         * @brief The arena cannot be shared by threads, so documents are always parsed on the calling thread
+         */
+        static inline ParseOptions single_threaded(ParseOptions options) noexcept
+        {
+            options.threads = 1;
+            return options;
+        }
+
+    public:
+        /**
+         * @brief Construct a new Document object
+         *
+         * @param initial_size the size of the first chunk of the arena
+         * @since v1.5
+         */
+        inline Document(size_t initial_size = 4096) : chunks(&upstream), arena(initial_size, &chunks)
+        {
+        }
+
+        Document(const Document &) = delete;
+        Document &operator=(const Document &) = delete;
+
+        /**
+         * @brief Parse a JSON string into the document, dropping the previous tree
+         *
+         * @param json_string
+         * @param options
+         * @return Json& the root of the document
+         * @since v1.5
+         */
+        inline Json &parse(std::string_view json_string, const ParseOptions &options = ParseOptions())
+        {
+            this->root = Json();
+            this->file.reset();
+            this->arena.release();
+            this->upstream.reset_counters();
+            JPP_STATS_ALLOCATIONS(&this->upstream);
+            this->root.parse(json_string, single_threaded(options), &this->arena);
+            return this->root;
+        }
+
+        /**
+         * @brief Parse a file into the document, dropping the previous tree. The file is mapped in memory
+         * and stays mapped until the document is parsed again or destroyed, so with borrow_strings
+         * the strings of the tree are views of the mapping
+         *
+         * @param path
+         * @param options
+         * @return Json& the root of the document
+         * @since v1.5
+         */
+        inline Json &open(const std::string &path, const ParseOptions &options = ParseOptions())
+        {
+            this->root = Json();
+            this->file.reset();
+            this->arena.release();
+            this->upstream.reset_counters();
+            JPP_STATS_ALLOCATIONS(&this->upstream);
+            this->file = std::make_shared<const MappedFile>(path);
+            this->root.parse_source(this->file, single_threaded(options), &this->arena);
+            return this->root;
+        }
+
+        /**
+         * @brief Get the root of the document
+         *
+         * @return Json&
+         * @since v1.5
+         */
+        inline Json &get_root() noexcept
+        {
+            return this->root;
+        }
+
+        /**
+         * @brief Drop the tree and give all the memory of the document back to the heap
+         * @since v1.5
+         */
+        inline void clear()
+        {
+            this->root = Json();
+            this->file.reset();
+            this->arena.release();
+            this->chunks.release();
+        }
+
+        /**
+         * @brief Get the number of bytes kept by the document for its tree and the next parses
+         *
+         * @return size_t
+         * @since v1.5
+         */
+        inline size_t get_capacity() const noexcept
+        {
+            return this->chunks.get_kept_bytes();
+        }
+
+        /**
+         * @brief Get the number of heap allocations made by the arena since the last parse,
+         * 0 when the chunks kept from the previous parses were enough
+         *
+         * @return size_t
+         * @since v1.5
+         */
+        inline size_t get_allocation_count() const noexcept
+        {
+            return this->upstream.get_allocation_count();
+        }
+
+        /**
+         * @brief Get the number of bytes allocated by the arena since the last parse
+         *
+         * @return size_t
+         * @since v1.5
+         */
+        inline size_t get_allocated_bytes() const noexcept
+        {
+            return this->upstream.get_allocated_bytes();
+        }
+    };
+
+    /**
+     * @brief An immutable JSON document that many threads can read at the same time through the const accessors of Json.
+     * By default the whole tree is materialized when the document is built, so reading it never writes;
+     * a lazy document instead parses each subtree once, on the first read from any thread, into a synchronized pool it owns.
+     * Copies share the same tree
+     * @example
+     *  Jpp::FrozenDocument config(json_string);
+     *  // on any thread
+     *  int64_t port = config.get_root()["server"]["port"].as_int64();
+     * @since v1.5
+     */
+    class FrozenDocument
+    {
+    private:
+        /**
+         * @brief The tree of a lazy document with the pool its subtrees are parsed into, which concurrent readers can share
+         */
+        struct Pooled
+        {
+            std::pmr::synchronized_pool_resource resource;
+            Json json;
+        };
+
+        std::shared_ptr<const Json> root;
+
+    public:
+        /**
+         * @brief Parse a JSON string into a frozen document
+         *
+         * @param json_string must outlive the document if the options borrow the strings
+         * @param options
+         * @param lazy parse the subtrees on their first read instead of now. Lazy documents copy their strings
+         * @since v1.5
+         */
+        explicit FrozenDocument(std::string_view json_string, ParseOptions options = ParseOptions(), bool lazy = false)
+        {
+            if (lazy)
+            {
+                std::shared_ptr<Pooled> pooled = std::make_shared<Pooled>();
+                options.borrow_strings = false;
+                pooled->json.parse(json_string, options, &pooled->resource);
+                this->root = std::shared_ptr<const Json>(pooled, &pooled->json);
+                return;
+            }
+            std::shared_ptr<Json> json = std::make_shared<Json>();
+            json->parse(json_string, options);
+            json->materialize();
+            this->root = std::move(json);
+        }
+
+        /**
+         * @brief Freeze a parsed JSON value
+         *
+         * @param json
+         * @param lazy keep the lazy subtrees to parse them on their first read. The value is then copied into
+         * the synchronized pool of the document, unless its memory resource is already safe to share between threads
+         * @since v1.5
+         */
+        explicit FrozenDocument(Json json, bool lazy = false)
+        {
+            if (lazy && !Json::is_synchronized(json.get_resource()))
+            {
+                std::shared_ptr<Pooled> pooled = std::make_shared<Pooled>();
+                pooled->json = Json(std::allocator_arg, &pooled->resource, std::move(json));
+                this->root = std::shared_ptr<const Json>(pooled, &pooled->json);
+                return;
+            }
+            std::shared_ptr<Json> frozen = std::make_shared<Json>(std::move(json));
+            if (!lazy)
+                frozen->materialize();
+            this->root = std::move(frozen);
+        }
+
+        /**
+         * @brief Get the root of the document
+         *
+         * @return const Json&
+         * @since v1.5
+         */
+        inline const Json &get_root() const noexcept
+        {
+            return *this->root;
+        }
+    };
+
+    /**
+     * @brief A parallel reader of JSON Lines (newline-delimited JSON). The input is split into chunks that end
+     * at a new line, the chunks are parsed by a pool of threads and the records are delivered in order
+     * @since v1.5
+     */
+    class JsonLines
+    {
+    private:
+        struct Chunk
+        {
+            size_t begin;
+            size_t end;
+            std::vector<Json> records;
+            std::exception_ptr error;
+            bool ready = false;
+        };
+
+        std::shared_ptr<const MappedFile> file;
+        std::string_view content;
+        size_t thread_count;
+        std::vector<Chunk> chunks;
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable chunk_ready;
+        std::condition_variable window_moved;
+        size_t next_chunk = 0;
+        size_t consumed = 0;
+        bool stopping = false;
+
+        void split(size_t chunk_size)
+        {
+            size_t begin = 0;
+
+            while (begin < this->content.length())
+            {
+                size_t end = std::min(begin + std::max<size_t>(chunk_size, 1), this->content.length());
+                size_t new_line = this->content.find('\n', end - 1);
+                end = new_line == std::string_view::npos ? this->content.length() : new_line + 1;
+                this->chunks.push_back(Chunk{begin, end, {}, nullptr, false});
+                begin = end;
+            }
+        }
+
+        void parse_chunk(Chunk &chunk)
+        {
+            size_t begin = chunk.begin;
+
+            while (begin < chunk.end)
+            {
+                size_t end = this->content.find('\n', begin);
+                if (end == std::string_view::npos || end > chunk.end)
+                    end = chunk.end;
+                std::string_view line = this->content.substr(begin, end - begin);
+                if (line.find_first_not_of(" \t\r\v\n") != std::string_view::npos)
+                {
+                    chunk.records.emplace_back();
+                    if (this->file)
+                        chunk.records.back().parse_range(this->content.substr(0, end), begin, std::shared_ptr<const char>(this->file, this->content.data()),
+                                                         ParseOptions(), std::pmr::get_default_resource());
+                    else
+                        chunk.records.back().parse(line, std::pmr::get_default_resource());
+                }
+                begin = end + 1;
+            }
+        }
+
+        void work()
+        {
+            while (true)
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->window_moved.wait(lock, [this]()
+                                        { return this->stopping || this->next_chunk >= this->chunks.size() ||
+                                                 this->next_chunk < this->consumed + 2 * this->thread_count; });
+                if (this->stopping || this->next_chunk >= this->chunks.size())
+                    return;
+                Chunk &chunk = this->chunks[this->next_chunk++];
+                lock.unlock();
+
+                try
+                {
+                    parse_chunk(chunk);
+                }
+                catch (...)
+                {
+                    chunk.error = std::current_exception();
+                }
+
+                lock.lock();
+                chunk.ready = true;
+                this->chunk_ready.notify_all();
+            }
+        }
+
+        void start()
+        {
+            if (!this->workers.empty() || this->chunks.empty())
+                return;
+            for (size_t i = 0; i < this->thread_count; ++i)
+                this->workers.emplace_back(&JsonLines::work, this);
+        }
+
+        /**
+         * @brief Wait for a chunk to be parsed, rethrowing the error of its records
+         */
+        Chunk &wait(size_t index)
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->chunk_ready.wait(lock, [this, index]()
+                                   { return this->chunks[index].ready; });
+            if (this->chunks[index].error)
+                std::rethrow_exception(this->chunks[index].error);
+            return this->chunks[index];
+        }
+
+        /**
+         * @brief Drop the records of a chunk and let the workers parse further
+         */
+        void release(size_t index)
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            std::vector<Json>().swap(this->chunks[index].records);
+            this->consumed = index + 1;
+            this->window_moved.notify_all();
+        }
+
+    public:
+        /**
+         * @brief Input iterator over the records, in the order of the input
+         * @since v1.5
+         */
+        class Iterator
+        {
+        private:
+            friend class JsonLines;
+
+            JsonLines *lines;
+            size_t chunk;
+            size_t record;
+
+            inline Iterator(JsonLines *lines, size_t chunk) : lines(lines), chunk(chunk), record(0)
+            {
+                skip_empty_chunks();
+            }
+
+            void skip_empty_chunks()
+            {
+                while (this->chunk < this->lines->chunks.size())
+                {
+                    Chunk &current = this->record == 0 ? this->lines->wait(this->chunk) : this->lines->chunks[this->chunk];
+                    if (this->record < current.records.size())
+                        return;
+                    this->lines->release(this->chunk++);
+                    this->record = 0;
+                }
+            }
+
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Json;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Json *;
+            using reference = Json &;
+
+            inline reference operator*() const
+            {
+                return this->lines->chunks[this->chunk].records[this->record];
+            }
+
+            inline pointer operator->() const
+            {
+                return &**this;
+            }
+
+            inline Iterator &operator++()
+            {
+                ++this->record;
+                skip_empty_chunks();
+                return *this;
+            }
+
+            inline bool operator==(const Iterator &other) const noexcept
+            {
+                return this->chunk == other.chunk && this->record == other.record;
+            }
+
+            inline bool operator!=(const Iterator &other) const noexcept
+            {
+                return !(*this == other);
+            }
+        };
+
+        /**
+         * @brief Construct a new JsonLines object reading a string, which must outlive the reader
+         *
+         * @param content
+         * @param threads the number of parsing threads, all the cores by default
+         * @param chunk_size the number of bytes parsed at a time by a thread, extended to the end of the line
+         * @since v1.5
          */
-        inline bool is_object() noexcept
+        inline JsonLines(std::string_view content, size_t threads = 0, size_t chunk_size = 1 << 20)
         {
-            return this->type == JSON_OBJECT;
+            this->content = content;
+            this->thread_count = threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+            split(chunk_size);
         }
 
         /**
-         * @brief Check if the JSON is an atomic string value
+         * @brief Construct a new JsonLines object reading a file mapped in memory.
+         * The lazy subtrees of the records refer to the mapping instead of copying their lines
          *
-         * @return true
-         * @return false
-         * @since v1.0
+         * @param file
+         * @param threads the number of parsing threads, all the cores by default
+         * @param chunk_size the number of bytes parsed at a time by a thread, extended to the end of the line
+         * @since v1.5
          */
-        inline bool is_string() noexcept
+        inline JsonLines(std::shared_ptr<const MappedFile> file, size_t threads = 0, size_t chunk_size = 1 << 20)
+            : JsonLines(file->get_content(), threads, chunk_size)
         {
-            return this->type == JSON_STRING;
+            this->file = std::move(file);
+        }
+
+        JsonLines(const JsonLines &) = delete;
+        JsonLines &operator=(const JsonLines &) = delete;
+
+        inline ~JsonLines()
+        {
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->stopping = true;
+            }
+            this->window_moved.notify_all();
+            for (std::thread &worker : this->workers)
+                worker.join();
         }
 
         /**
-         * @brief Check if the JSON is an atomic boolean value
+         * @brief Start the parsing threads and get the first record. The records can be read only once
          *
-         * @return true
-         * @return false
-         * @since v1.0
+         * @return Iterator
+         * @since v1.5
          */
-        inline bool is_boolean() noexcept
+        inline Iterator begin()
         {
-            return this->type == JSON_BOOLEAN;
+            start();
+            return Iterator(this, this->consumed);
         }
 
         /**
-         * @brief Check if the JSON is an atomic double value
+         * @brief Get the end of the records
          *
-         * @return true
-         * @return false
-         * @since v1.0
+         * @return Iterator
+         * @since v1.5
          */
-        inline bool is_number() noexcept
+        inline Iterator end()
         {
-            return this->type == JSON_NUMBER;
+            return Iterator(this, this->chunks.size());
         }
 
         /**
-         * @brief Parse a JSON string
-         * @since v1.0
+         * @brief Call a function for every record, in order, on the calling thread
+         *
+         * @param callback called with a Json &, the record can be moved away
+         * @since v1.5
          */
-        void parse(const std::string &json_string)
+        template <typename Callback>
+        void for_each(Callback callback)
         {
-            size_t start = 0;
-            this->is_resolved = true;
-            if (json_string[start] == '{')
+            for (Json &record : *this)
+                callback(record);
+        }
+    };
+
+    /**
+     * @brief A handler of Json::read and PushParser that builds the tree of the parsed value
+     * @since v1.5
+     */
+    class Builder : public Handler
+    {
+    private:
+        std::pmr::memory_resource *resource;
+        std::pmr::vector<Json> stack;
+        std::pmr::vector<Key> keys;
+        Json root;
+
+        void add(Json &&value)
+        {
+            if (this->stack.empty())
             {
-                this->children = parse_object(json_string, start);
-                this->unresolved_string = "";
-                this->type = Jpp::JSON_OBJECT;
+                this->root = std::move(value);
                 return;
             }
-            if (json_string[start] == '[')
+            Json &parent = this->stack.back();
+            if (parent.is_array())
             {
-                this->children = parse_array(json_string, start);
-                this->unresolved_string = "";
-                this->type = Jpp::JSON_ARRAY;
+                std::get<Json::Array>(parent.value).push_back(std::move(value));
                 return;
             }
-            throw std::runtime_error("Unexpected " + std::string(1, json_string[0]) + " at the beginning of the string");
+            std::get<Json::Object>(parent.value).append_unique(std::move(this->keys.back()), std::move(value));
+            this->keys.pop_back();
         }
 
+        bool end()
+        {
+            Json value = std::move(this->stack.back());
+            this->stack.pop_back();
+            if (value.is_object())
+                std::get<Json::Object>(value.value).sort_by_name();
+            add(std::move(value));
+            return true;
+        }
+
+    public:
         /**
-         * @brief Get the children object
+         * @brief Construct a new Builder object
          *
-         * @return std::map<std::string, Json>
-         * @since v1.0
+         * @param resource the memory resource of the tree, it must outlive the tree
+         * @since v1.5
          */
-        inline std::map<std::string, Json> get_children()
+        inline Builder(std::pmr::memory_resource *resource = std::pmr::get_default_resource()) : resource(resource), stack(resource), keys(resource)
         {
-            if (!is_resolved)
-                parse(unresolved_string);
-            return this->children;
         }
 
-        /**
-         * @brief Access to a position of the array
-         * @example
-         *  Jpp::Json json;
-         *  json.parse("[0, 1, 2, 3]");
-         *  json[0] // returns an any value
-         * @return Json&
-         * @since v1.0
-         */
-        inline Json &operator[](size_t index)
+        inline bool on_object_start()
         {
-            if (this->type > Jpp::JSON_OBJECT)
-                throw std::out_of_range("Cannot use the subscript operator with an atomic value, use get_value");
-            if (!is_resolved)
-                parse(unresolved_string);
-            return this->children[std::to_string(index)];
+            this->stack.emplace_back(Json::Object(this->resource));
+            return true;
+        }
+
+        inline bool on_object_end()
+        {
+            return end();
+        }
+
+        inline bool on_array_start()
+        {
+            this->stack.emplace_back(Json::Array(this->resource));
+            return true;
+        }
+
+        inline bool on_array_end()
+        {
+            return end();
+        }
+
+        inline bool on_key(std::string_view key)
+        {
+            this->keys.emplace_back(key);
+            return true;
+        }
+
+        inline bool on_string(std::string_view str)
+        {
+            add(Json(std::pmr::string(str, this->resource)));
+            return true;
+        }
+
+        inline bool on_number(const Json &number)
+        {
+            add(Json(number));
+            return true;
+        }
+
+        inline bool on_bool(bool value)
+        {
+            add(Json(value));
+            return true;
+        }
+
+        inline bool on_null()
+        {
+            add(Json(nullptr));
+            return true;
         }
 
         /**
-         * @brief Access to a value of the object with the given property name
+         * @brief Get the built value
          *
          * @return Json&
-         * @since v1.0
+         * @since v1.5
          */
-        inline Json &operator[](const std::string &property)
+        inline Json &get_root() noexcept
         {
-            if (this->type > Jpp::JSON_OBJECT)
-                throw std::out_of_range("Cannot use the subscript operator with an atomic value, use get_value");
-            if (this->type == Jpp::JSON_OBJECT && this->children.find(property) == this->children.end())
-                this->children.emplace(property, Json(nullptr));
-            if (!is_resolved)
-                parse(unresolved_string);
-            return this->children.at(property);
+            return this->root;
         }
+    };
 
-        /**
-         * @return Json&
-         * @since v1.0
-         */
-        inline Json &operator=(const std::string &str)
+    /**
+     * @brief A resumable parser for input that arrives in pieces. Every chunk is parsed as soon as it is fed,
+     * and only the string or primitive cut by the end of a chunk is kept; the values are reported to the handler
+     * @since v1.5
+     */
+    template <typename Handler>
+    class PushParser
+    {
+    private:
+        enum State
         {
-            this->children.clear();
-            this->is_resolved = true;
-            this->type = Jpp::JSON_STRING;
-            this->value = str;
+            ROOT,
+            KEY_OR_END,
+            COLON,
+            VALUE,
+            VALUE_OR_END,
+            COMMA_OR_END,
+            STRING,
+            SCALAR,
+            DONE
+        };
 
-            return *this;
+        Handler &handler;
+        State state;
+        std::pmr::vector<char> containers;
+        std::pmr::string pending;
+        std::pmr::string decoded;
+        Json number;
+        size_t position;
+        char quote;
+        bool escape;
+        bool has_escapes;
+        bool is_key;
+        bool stopped;
+
+        static inline bool is_space(char ch) noexcept
+        {
+            return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\v';
         }
 
-        /**
-         * @return Json&
-         * @since v1.0
-         */
-        inline Json &operator=(double val)
+        static inline bool ends_scalar(char ch) noexcept
         {
-            this->children.clear();
-            this->is_resolved = true;
-            this->type = Jpp::JSON_NUMBER;
-            this->value = val;
+            switch (ch)
+            {
+            case ',':
+            case ':':
+            case '[':
+            case ']':
+            case '{':
+            case '}':
+            case '"':
+            case '\'':
+                return true;
+            }
+            return is_space(ch);
+        }
 
-            return *this;
+        std::runtime_error error(const std::string &message) const
+        {
+            return std::runtime_error(message + " at position: " + std::to_string(this->position));
         }
 
-        /**
-         * @return Json&
-         * @since v1.0
-         */
-        inline Json &operator=(int val)
+        void after_value()
         {
-            this->children.clear();
-            this->is_resolved = true;
-            this->type = Jpp::JSON_NUMBER;
-            this->value = static_cast<double>(val);
+            this->state = this->containers.empty() ? DONE : COMMA_OR_END;
+        }
 
-            return *this;
+        bool start_container(char ch)
+        {
+            this->containers.push_back(ch);
+            this->state = ch == '{' ? KEY_OR_END : VALUE_OR_END;
+            return ch == '{' ? this->handler.on_object_start() : this->handler.on_array_start();
         }
 
-        /**
-         * @return Json&
-         * @since v1.0
-         */
-        inline Json &operator=(bool val)
+        bool end_container()
         {
-            this->children.clear();
-            this->is_resolved = true;
-            this->type = Jpp::JSON_BOOLEAN;
-            this->value = val;
+            char container = this->containers.back();
+            this->containers.pop_back();
+            after_value();
+            return container == '{' ? this->handler.on_object_end() : this->handler.on_array_end();
+        }
 
-            return *this;
+        void start_string(char ch, bool is_key)
+        {
+            this->state = STRING;
+            this->quote = ch;
+            this->escape = false;
+            this->has_escapes = false;
+            this->is_key = is_key;
+            this->pending.clear();
         }
 
-        /**
-         * @return Json&
-         * @since v1.0
-         */
-        inline Json &operator=(const char str[])
+        bool end_string(std::string_view raw)
         {
-            this->children.clear();
-            this->is_resolved = true;
-            this->type = Jpp::JSON_STRING;
-            this->value = std::string(str);
+            std::string_view str = raw;
 
-            return *this;
+            if (this->has_escapes)
+            {
+                this->decoded.clear();
+                Json::append_decoded(raw, this->decoded);
+                str = this->decoded;
+            }
+            if (this->is_key)
+            {
+                this->state = COLON;
+                return this->handler.on_key(str);
+            }
+            after_value();
+            return this->handler.on_string(str);
         }
 
-        /**
-         * @return Json&
-         * @since v1.4
-         */
-        inline Json &operator=(std::vector<std::any> array)
+        bool end_scalar(std::string_view token)
         {
-            this->children.clear();
-            this->type = Jpp::JSON_ARRAY;
-            this->is_resolved = true;
-            for (size_t i = 0; i < array.size(); ++i)
+            after_value();
+            if ((token[0] >= '0' && token[0] <= '9') || token[0] == '-')
             {
-                this->children.emplace(std::to_string(i), Json(array[i]));
+                if (!Json::convert_number(token, this->number))
+                    throw error("Invalid number: " + std::string(token));
+                return this->handler.on_number(static_cast<const Json &>(this->number));
             }
-            return *this;
+            if (token == "null")
+                return this->handler.on_null();
+            if (token == "true" || token == "false")
+                return this->handler.on_bool(token == "true");
+            if (isalpha(static_cast<unsigned char>(token[0])))
+                throw error("Unrecognized token: " + std::string(token));
+            throw error("Unexpected " + std::string(1, token[0]) + " token");
         }
 
         /**
-         * @return Json&
-         * @since v1.4
+         * @brief Consume the string that continues at the start of the chunk, returning the number of bytes used
          */
-        inline Json &operator=(std::vector<std::pair<std::string, std::any>> object)
+        size_t feed_string(std::string_view chunk, size_t index, bool &keep_going)
         {
-            this->children.clear();
-            this->type = Jpp::JSON_OBJECT;
-            this->is_resolved = true;
-            for (size_t i = 0; i < object.size(); ++i)
+            size_t start = index;
+
+            while (index < chunk.length())
             {
-                this->children.emplace(object[i].first, Json(object[i].second));
+                char ch = chunk[index];
+                if (this->escape)
+                    this->escape = false;
+                else if (ch == '\\')
+                {
+                    this->escape = true;
+                    this->has_escapes = true;
+                }
+                else if (ch == this->quote)
+                {
+                    if (this->pending.empty())
+                        keep_going = end_string(chunk.substr(start, index - start));
+                    else
+                    {
+                        this->pending.append(chunk.substr(start, index - start));
+                        keep_going = end_string(this->pending);
+                    }
+                    return index + 1;
+                }
+                else if (ch == '\n')
+                {
+                    this->position += index - start;
+                    throw error("Unexpected end of the line while parsing the string: '" + std::string(this->pending) + std::string(chunk.substr(start, index - start)) + "'");
+                }
+                ++index;
             }
-            return *this;
+            this->pending.append(chunk.substr(start));
+            return index;
         }
 
-        /**
-         * @brief Convert the JSON object to its JSON representation.
-         *
-         * @return std::string
-         */
-        inline std::string to_string()
+        size_t feed_scalar(std::string_view chunk, size_t index, bool &keep_going)
         {
-            switch (this->type)
+            size_t start = index;
+
+            while (index < chunk.length() && !ends_scalar(chunk[index]))
+                ++index;
+            if (index == chunk.length())
             {
-            case Jpp::JSON_OBJECT:
-                return json_object_to_string(*this);
-            case Jpp::JSON_ARRAY:
-                return json_array_to_string(*this);
-            case Jpp::JSON_STRING:
-                return "\"" +
-                       str_replace(
-                           str_replace(std::any_cast<std::string>(this->value), '"', "\\\""), '\n', "\\n") +
-                       "\"";
-            case Jpp::JSON_BOOLEAN:
-                return std::any_cast<bool>(this->value) ? "true" : "false";
-            case Jpp::JSON_NUMBER:
-                return std::to_string(std::any_cast<double>(this->value));
-            case Jpp::JSON_NULL:
-                return "null";
+                this->pending.append(chunk.substr(start));
+                return index;
             }
-            return "";
+            if (this->pending.empty())
+                keep_going = end_scalar(chunk.substr(start, index - start));
+            else
+            {
+                this->pending.append(chunk.substr(start, index - start));
+                keep_going = end_scalar(this->pending);
+            }
+            return index;
         }
 
-        /**
-         * @brief Begin iterator
-         *
-         * @return std::map<std::string, Json>::iterator
-         * @since v1.1
-         */
-        inline std::map<std::string, Json>::iterator begin() noexcept
+        bool feed_char(char ch)
         {
-            return children.begin();
+            switch (this->state)
+            {
+            case ROOT:
+                if (ch == '{' || ch == '[')
+                    return start_container(ch);
+                throw std::runtime_error("Unexpected " + std::string(1, ch) + " at the beginning of the string");
+            case KEY_OR_END:
+                switch (ch)
+                {
+                case '}':
+                    return end_container();
+                case '"':
+                case '\'':
+                    start_string(ch, true);
+                    return true;
+                case '[':
+                    throw error("Unexpected the start of an array, expected a property name");
+                case ']':
+                    throw error("Unexpected the end of an array, expected a property name");
+                case '{':
+                    throw error("Unexpected the start of an object, expected a property name");
+                case ',':
+                    throw error("Unexpected separator, expected a property name");
+                }
+                if ((ch >= '0' && ch <= '9') || ch == '-')
+                    throw error("Unexpected a number value, expected a property name");
+                if (isalpha(static_cast<unsigned char>(ch)))
+                    throw error("Unexpected a boolean value, expected a property name");
+                throw error("Unexpected " + std::string(1, ch) + " token");
+            case COLON:
+                if (ch != ':')
+                    throw error("Expected ':'");
+                this->state = VALUE;
+                return true;
+            case VALUE:
+            case VALUE_OR_END:
+                switch (ch)
+                {
+                case '{':
+                case '[':
+                    return start_container(ch);
+                case '"':
+                case '\'':
+                    start_string(ch, false);
+                    return true;
+                case ']':
+                    if (this->state == VALUE_OR_END)
+                        return end_container();
+                    throw error("Unexpected the end of an array, a value is expected");
+                case '}':
+                    if (this->state == VALUE_OR_END)
+                        throw error("Unexpected '}' token, a value is expected");
+                    throw error("Unexpected the end of the object, a value is expected");
+                case ',':
+                case ':':
+                    throw error("Unexpected separator, a value is expected");
+                }
+                this->state = SCALAR;
+                this->pending.clear();
+                return true;
+            case COMMA_OR_END:
+                if (this->containers.back() == '{')
+                {
+                    if (ch == ',')
+                        this->state = KEY_OR_END;
+                    else if (ch == '}')
+                        return end_container();
+                    else
+                        throw error("Expected a ',' or the end of the object");
+                    return true;
+                }
+                if (ch == ',')
+                    this->state = VALUE_OR_END;
+                else if (ch == ']')
+                    return end_container();
+                else
+                    throw error("Expected a ',' or the end of the array");
+                return true;
+            default:
+                return true;
+            }
         }
 
+    public:
         /**
-         * @brief End iterator
+         * @brief Construct a new PushParser object
          *
-         * @return std::map<std::string, Json>::iterator
-         * @since v1.1
+         * @param handler receives the values, it must outlive the parser
+         * @param resource the memory resource of the pieces kept between chunks
+         * @since v1.5
          */
-        inline std::map<std::string, Json>::iterator end() noexcept
+        inline PushParser(Handler &handler, std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+            : handler(handler), containers(resource), pending(resource), decoded(resource), number(int64_t(0))
         {
-            return children.end();
+            reset();
         }
 
         /**
-         * @brief Reverse begin iterator
+         * @brief Parse the next piece of the input
          *
-         * @return std::map<std::string, Json>::iterator
-         * @since v1.1
+         * @param chunk it can be released as soon as the call returns
+         * @return true if the parsing can go on, false if the handler stopped it
+         * @since v1.5
          */
-        inline std::map<std::string, Json>::reverse_iterator rbegin() noexcept
+        bool feed(std::string_view chunk)
         {
-            return children.rbegin();
+            size_t index = 0;
+            bool keep_going = true;
+
+            while (index < chunk.length() && !this->stopped && this->state != DONE)
+            {
+                size_t start = index;
+                if (this->state == STRING)
+                    index = feed_string(chunk, index, keep_going);
+                else if (this->state == SCALAR)
+                    index = feed_scalar(chunk, index, keep_going);
+                else if (is_space(chunk[index]))
+                    ++index;
+                else
+                {
+                    keep_going = feed_char(chunk[index]);
+                    if (this->state != SCALAR)
+                        ++index;
+                }
+                this->position += index - start;
+                this->stopped = !keep_going;
+            }
+            return !this->stopped;
         }
 
         /**
-         * @brief Reverse end iterator
+         * @brief Signal the end of the input
          *
-         * @return std::map<std::string, Json>::iterator
-         * @since v1.1
+         * @return true if a whole value was parsed, false if the handler stopped the parsing
+         * @since v1.5
          */
-        inline std::map<std::string, Json>::reverse_iterator rend() noexcept
+        bool finish()
         {
-            return children.rend();
+            if (this->stopped)
+                return false;
+            if (this->state != DONE)
+                throw error("Unexpected the end of the string");
+            return true;
         }
 
         /**
-         * @brief Get the vector if the JSON object is an array
-         *
-         * @return std::vector<Json>
-         * @since v1.2
+         * @brief Prepare the parser for a new input, keeping the handler
+         * @since v1.5
          */
-        inline std::vector<Json> get_vector()
+        void reset() noexcept
         {
-            if (type != JSON_ARRAY)
-                throw std::runtime_error("Cannot convert a non-array JSON to a vector");
-            std::vector<Jpp::Json> vct;
-            for (auto json : children)
-            {
-                vct.push_back(json.second);
-            }
-            return vct;
+            this->state = ROOT;
+            this->containers.clear();
+            this->pending.clear();
+            this->position = 0;
+            this->quote = 0;
+            this->escape = false;
+            this->has_escapes = false;
+            this->is_key = false;
+            this->stopped = false;
         }
     };
-};
\ No newline at end of file
+};
@@ -0,0 +1,374 @@
+#include "jpp.hh"
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <random>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+
+static std::atomic<size_t> allocation_count = 0;
+static std::atomic<size_t> allocated_bytes = 0;
+
+// the replaced operators share one allocation pair, kept out of line so that the compiler does not pair malloc with delete
+[[gnu::noinline]] static void *counted_alloc(size_t size, size_t alignment)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    void *pointer = alignment <= alignof(std::max_align_t) ? std::malloc(size ? size : 1)
+                                                           : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+[[gnu::noinline]] static void counted_free(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void *operator new(size_t size)
+{
+    return counted_alloc(size, alignof(std::max_align_t));
+}
+
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    return counted_alloc(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void *pointer) noexcept
+{
+    counted_free(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept
+{
+    counted_free(pointer);
+}
+
+void operator delete(void *pointer, size_t, std::align_val_t) noexcept
+{
+    counted_free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    counted_free(pointer);
+}
+
+struct Allocations
+{
+    size_t count;
+    size_t bytes;
+};
+
+template <typename F>
+static Allocations count_allocations(F function)
+{
+    size_t count = allocation_count.load();
+    size_t bytes = allocated_bytes.load();
+    function();
+    return Allocations{allocation_count.load() - count, allocated_bytes.load() - bytes};
+}
+
+/**
+ * @brief Best time of the repetitions in nanoseconds. The setup runs before every repetition and is not timed
+ */
+template <typename Setup, typename F>
+static double best_ns(int repetitions, Setup setup, F function)
+{
+    double best = 0;
+    for (int i = 0; i < repetitions; ++i)
+    {
+        setup();
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        if (i == 0 || elapsed.count() < best)
+            best = elapsed.count();
+    }
+    return best;
+}
+
+static std::mt19937_64 random_engine(42);
+
+static std::string random_word(size_t min_length, size_t max_length)
+{
+    static const char letters[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+    size_t length = min_length + random_engine() % (max_length - min_length + 1);
+    std::string word;
+    for (size_t i = 0; i < length; ++i)
+        word += letters[random_engine() % (sizeof(letters) - 1)];
+    return word;
+}
+
+static std::string random_text(size_t words)
+{
+    std::string text;
+    for (size_t i = 0; i < words; ++i)
+    {
+        if (i > 0)
+            text += random_engine() % 16 == 0 ? "\\n" : " ";
+        if (random_engine() % 20 == 0)
+            text += "\\\"" + random_word(3, 8) + "\\\"";
+        else
+            text += random_word(1, 10);
+    }
+    return text;
+}
+
+static std::string make_twitter(size_t statuses)
+{
+    std::string json = "{\"statuses\": [";
+    for (size_t i = 0; i < statuses; ++i)
+    {
+        uint64_t id = 505874924095815681ull + random_engine() % 1000000;
+        if (i > 0)
+            json += ",";
+        json += "\n  {\"id\": " + std::to_string(id) + ", \"id_str\": \"" + std::to_string(id) + "\"";
+        json += ", \"created_at\": \"Sun Aug 31 00:29:15 +0000 2014\"";
+        json += ", \"text\": \"" + random_text(5 + random_engine() % 20) + "\"";
+        json += ", \"user\": {\"id\": " + std::to_string(random_engine() % 3000000000ull) + ", \"name\": \"" + random_word(4, 12) + "\"";
+        json += ", \"screen_name\": \"" + random_word(4, 15) + "\", \"location\": " + (random_engine() % 3 ? "\"" + random_word(3, 10) + "\"" : std::string("null"));
+        json += ", \"followers_count\": " + std::to_string(random_engine() % 100000) + ", \"verified\": " + (random_engine() % 10 ? "false" : "true") + "}";
+        json += ", \"entities\": {\"hashtags\": [";
+        size_t hashtags = random_engine() % 4;
+        for (size_t j = 0; j < hashtags; ++j)
+            json += (j ? ", " : "") + std::string("{\"text\": \"") + random_word(3, 12) + "\", \"indices\": [" + std::to_string(j * 10) + ", " + std::to_string(j * 10 + 8) + "]}";
+        json += "], \"urls\": []}";
+        json += ", \"retweet_count\": " + std::to_string(random_engine() % 1000) + ", \"favorited\": false, \"lang\": \"en\"}";
+    }
+    json += "],\n\"search_metadata\": {\"completed_in\": 0.087, \"max_id\": 505874924095815681, \"count\": " + std::to_string(statuses) + "}}";
+    return json;
+}
+
+static std::string make_numbers(size_t count)
+{
+    std::string json = "[";
+    char buffer[64];
+    for (size_t i = 0; i < count; ++i)
+    {
+        int length;
+        if (i % 3 == 0)
+            length = std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(random_engine() % 2000000) - 1000000);
+        else if (i % 3 == 1)
+            length = std::snprintf(buffer, sizeof(buffer), "%.6f", static_cast<double>(random_engine() % 100000000) / 1000.0);
+        else
+            length = std::snprintf(buffer, sizeof(buffer), "%.8e", static_cast<double>(random_engine() % 1000000) * 1e-7);
+        if (i > 0)
+            json += ",";
+        json.append(buffer, length);
+    }
+    return json + "]";
+}
+
+static std::string make_strings(size_t count)
+{
+    std::string json = "[";
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i > 0)
+            json += ",";
+        json += "\"" + random_text(1 + random_engine() % 12) + "\"";
+    }
+    return json + "]";
+}
+
+static std::string make_deep(size_t depth)
+{
+    std::string json;
+    for (size_t i = 0; i < depth; ++i)
+        json += i % 2 ? "[" : "{\"level\": " + std::to_string(i) + ", \"next\": ";
+    json += "\"bottom\"";
+    for (size_t i = depth; i > 0; --i)
+        json += (i - 1) % 2 ? "]" : "}";
+    return json;
+}
+
+static std::string make_wide(size_t keys)
+{
+    std::string json = "{";
+    for (size_t i = 0; i < keys; ++i)
+    {
+        if (i > 0)
+            json += ", ";
+        json += "\"" + random_word(4, 16) + "_" + std::to_string(i) + "\": ";
+        json += i % 2 ? std::to_string(random_engine() % 100000) : "\"" + random_word(2, 10) + "\"";
+    }
+    return json + "}";
+}
+
+static size_t walk(Jpp::Json &json)
+{
+    size_t nodes = 1;
+    if (json.is_array() || json.is_object())
+        for (auto child : json)
+            nodes += walk(child.second);
+    return nodes;
+}
+
+static Jpp::Json measure(const std::string &name, const std::string &text, int repetitions)
+{
+    Jpp::Json result;
+    Jpp::Json json;
+    std::string output;
+    volatile size_t sink = 0;
+
+    auto parse = [&]()
+    { json.parse(text); };
+    auto reset = [&]()
+    { json = Jpp::Json(); };
+
+    double parse_ns = best_ns(repetitions, reset, parse);
+    reset();
+    Allocations parse_allocations = count_allocations(parse);
+
+    // nested objects are parsed when first accessed, so the whole tree is only built by visiting it
+    auto materialize = [&]()
+    {
+        json.parse(text);
+        walk(json);
+    };
+    double materialize_ns = best_ns(repetitions, reset, materialize);
+    reset();
+    Allocations materialize_allocations = count_allocations(materialize);
+
+    // serialization and traversal work on a fully materialized tree
+    sink = walk(json);
+    auto serialize = [&]()
+    { output = json.to_string(); };
+    double serialize_ns = best_ns(repetitions, [&]()
+                                  { output.clear(); }, serialize);
+    Allocations serialize_allocations = count_allocations(serialize);
+
+    // a document parsed again keeps the chunks of its arena, so the steady state should not allocate
+    Jpp::Document document;
+    auto reparse = [&]()
+    { walk(document.parse(text)); };
+    reparse();
+    double reparse_ns = best_ns(repetitions, []() {}, reparse);
+    Allocations reparse_allocations = count_allocations(reparse);
+
+    // the binary decoder builds the whole tree, so it is compared with parsing and materializing
+    std::string binary;
+    double encode_ns = best_ns(repetitions, [&]()
+                               { binary.clear(); }, [&]()
+                               { binary = json.to_binary(); });
+    Jpp::Json decoded;
+    double decode_ns = best_ns(repetitions, [&]()
+                               { decoded = Jpp::Json(); }, [&]()
+                               { decoded = Jpp::Json::from_binary(binary); });
+
+    // iteration and random access include materializing the lazy subtrees they touch
+    size_t nodes = 0;
+    double walk_ns = best_ns(repetitions, parse, [&]()
+                             { nodes = walk(json); });
+
+    std::vector<std::string> keys;
+    size_t length = 0;
+    if (json.is_object())
+        for (auto child : json)
+            keys.emplace_back(child.first);
+    else
+        length = json.size();
+    const size_t lookups = 100000;
+    std::vector<size_t> picks(lookups);
+    for (size_t &pick : picks)
+        pick = random_engine() % std::max<size_t>(json.is_object() ? keys.size() : length, 1);
+    double access_ns = best_ns(repetitions, parse, [&]()
+                               {
+        size_t total = 0;
+        for (size_t pick : picks)
+            total += json.is_object() ? json[keys[pick]].get_type() : json[pick].get_type();
+        sink = total; });
+
+    std::cerr << name << ": " << text.size() << " bytes, parse " << text.size() / parse_ns * 1e3 << " MB/s, parse and materialize "
+              << text.size() / materialize_ns * 1e3 << " MB/s, serialize "
+              << output.size() / serialize_ns * 1e3 << " MB/s, binary decode " << materialize_ns / decode_ns << "x faster, "
+              << materialize_allocations.count << " allocations, " << reparse_allocations.count << " when reusing a document" << std::endl;
+
+    Jpp::Json parse_result;
+    parse_result["ns"] = parse_ns;
+    parse_result["mb_per_s"] = text.size() / parse_ns * 1e3;
+    parse_result["allocations"] = static_cast<uint64_t>(parse_allocations.count);
+    parse_result["allocated_bytes"] = static_cast<uint64_t>(parse_allocations.bytes);
+
+    Jpp::Json materialize_result;
+    materialize_result["ns"] = materialize_ns;
+    materialize_result["mb_per_s"] = text.size() / materialize_ns * 1e3;
+    materialize_result["allocations"] = static_cast<uint64_t>(materialize_allocations.count);
+    materialize_result["allocated_bytes"] = static_cast<uint64_t>(materialize_allocations.bytes);
+
+    Jpp::Json reparse_result;
+    reparse_result["ns"] = reparse_ns;
+    reparse_result["mb_per_s"] = text.size() / reparse_ns * 1e3;
+    reparse_result["allocations"] = static_cast<uint64_t>(reparse_allocations.count);
+    reparse_result["allocated_bytes"] = static_cast<uint64_t>(reparse_allocations.bytes);
+
+    Jpp::Json serialize_result;
+    serialize_result["ns"] = serialize_ns;
+    serialize_result["output_bytes"] = static_cast<uint64_t>(output.size());
+    serialize_result["mb_per_s"] = output.size() / serialize_ns * 1e3;
+    serialize_result["allocations"] = static_cast<uint64_t>(serialize_allocations.count);
+    serialize_result["allocated_bytes"] = static_cast<uint64_t>(serialize_allocations.bytes);
+
+    Jpp::Json binary_result;
+    binary_result["bytes"] = static_cast<uint64_t>(binary.size());
+    binary_result["encode_ns"] = encode_ns;
+    binary_result["decode_ns"] = decode_ns;
+    binary_result["decode_mb_per_s"] = binary.size() / decode_ns * 1e3;
+    binary_result["decode_speedup"] = materialize_ns / decode_ns;
+
+    Jpp::Json iteration_result;
+    iteration_result["ns"] = walk_ns;
+    iteration_result["ns_per_node"] = walk_ns / nodes;
+
+    Jpp::Json access_result;
+    access_result["lookups"] = static_cast<uint64_t>(lookups);
+    access_result["ns_per_op"] = access_ns / lookups;
+
+    result["corpus"] = name;
+    result["bytes"] = static_cast<uint64_t>(text.size());
+    result["nodes"] = static_cast<uint64_t>(nodes);
+    result["parse"] = parse_result;
+    result["parse_and_materialize"] = materialize_result;
+    result["document_reparse"] = reparse_result;
+    result["serialize"] = serialize_result;
+    result["binary"] = binary_result;
+    result["iteration"] = iteration_result;
+    result["random_access"] = access_result;
+    return result;
+}
+
+int main(int argc, char **argv)
+{
+    const int repetitions = 5;
+    std::vector<std::pair<std::string, std::string>> corpus = {
+        {"twitter", make_twitter(3000)},
+        {"numbers", make_numbers(200000)},
+        {"strings", make_strings(100000)},
+        {"deep", make_deep(400)},
+        {"wide", make_wide(50000)},
+    };
+
+    Jpp::Json report;
+    report["library"] = "jpp";
+    report["repetitions"] = repetitions;
+    report["results"] = Jpp::Json(std::vector<Jpp::Json>());
+    for (auto &document : corpus)
+        report["results"].push_back(measure(document.first, document.second, repetitions));
+
+    if (argc > 1)
+    {
+        std::ofstream file(argv[1]);
+        report.write(file);
+        file << std::endl;
+    }
+    else
+    {
+        report.write(std::cout);
+        std::cout << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include "jpp.hh"
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <cstdio>
+
+struct Corpus
+{
+    std::string json;
+    std::vector<std::string_view> tokens;
+    std::vector<uint64_t> ids;
+};
+
+static Corpus make_corpus(size_t count)
+{
+    Corpus corpus;
+    std::mt19937_64 random(42);
+    std::vector<std::pair<size_t, size_t>> spans;
+    char buffer[64];
+
+    corpus.json = "[";
+    for (size_t i = 0; i < count; ++i)
+    {
+        int length = 0;
+        switch (i % 4)
+        {
+        case 0:
+            length = std::snprintf(buffer, sizeof(buffer), "%d", static_cast<int>(random() % 100000) - 50000);
+            break;
+        case 1:
+        {
+            uint64_t id = (1ull << 53) + random() % (1ull << 62);
+            corpus.ids.push_back(id);
+            length = std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(id));
+            break;
+        }
+        case 2:
+            length = std::snprintf(buffer, sizeof(buffer), "%.3f", static_cast<double>(random() % 10000000) / 1000.0);
+            break;
+        case 3:
+            length = std::snprintf(buffer, sizeof(buffer), "%.6e", static_cast<double>(random() % 1000000) * 1e-9);
+            break;
+        }
+        if (i > 0)
+            corpus.json += ',';
+        spans.emplace_back(corpus.json.size(), static_cast<size_t>(length));
+        corpus.json.append(buffer, length);
+    }
+    corpus.json += "]";
+
+    for (auto &span : spans)
+        corpus.tokens.emplace_back(corpus.json.data() + span.first, span.second);
+    return corpus;
+}
+
+template <typename F>
+static double best_ns(int repetitions, F function)
+{
+    double best = 0;
+    for (int i = 0; i < repetitions; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+        if (i == 0 || elapsed.count() < best)
+            best = elapsed.count();
+    }
+    return best;
+}
+
+int main()
+{
+    const size_t count = 400'000;
+    const int repetitions = 5;
+    Corpus corpus = make_corpus(count);
+    volatile double sink = 0;
+
+    // the conversion used up to v1.4 was std::stod(substr.data()), which also copied the whole rest
+    // of the buffer into a temporary std::string; only the token is copied here to keep the baseline linear
+    double stod_ns = best_ns(repetitions, [&]()
+                             {
+        double sum = 0;
+        for (std::string_view token : corpus.tokens)
+            sum += std::stod(std::string(token));
+        sink = sum; });
+
+    double from_chars_ns = best_ns(repetitions, [&]()
+                                   {
+        double sum = 0;
+        for (std::string_view token : corpus.tokens)
+            sum += Jpp::Json::from_number(token).as_double();
+        sink = sum; });
+
+    double parse_ns = best_ns(repetitions, [&]()
+                              {
+        Jpp::Json json;
+        json.parse(corpus.json);
+        sink = json[0].as_double(); });
+
+    // up to v1.5 doubles were written with snprintf("%f"), as std::to_string does: six fixed decimals through the locale
+    Jpp::Json parsed;
+    parsed.parse(corpus.json);
+    std::vector<double> values;
+    for (auto element : parsed)
+        values.push_back(element.second.as_double());
+    Jpp::Json doubles = Jpp::Json(std::vector<Jpp::Json>(values.begin(), values.end()));
+    std::string fixed_output;
+    std::string shortest_output;
+
+    double fixed_ns = best_ns(repetitions, [&]()
+                              {
+        char buffer[512];
+        fixed_output = "[";
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (i > 0)
+                fixed_output += ',';
+            fixed_output.append(buffer, std::snprintf(buffer, sizeof(buffer), "%f", values[i]));
+        }
+        fixed_output += ']'; });
+
+    double shortest_ns = best_ns(repetitions, [&]()
+                                 { shortest_output = doubles.to_string(); });
+
+    size_t fixed_lossy = 0;
+    size_t shortest_lossy = 0;
+    Jpp::Json fixed_parsed;
+    Jpp::Json shortest_parsed;
+    fixed_parsed.parse(fixed_output);
+    shortest_parsed.parse(shortest_output);
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        fixed_lossy += fixed_parsed[i].as_double() != values[i];
+        shortest_lossy += shortest_parsed[i].as_double() != values[i];
+    }
+
+    size_t stod_lossy = 0;
+    size_t jpp_lossy = 0;
+    for (uint64_t id : corpus.ids)
+    {
+        std::string text = std::to_string(id);
+        if (static_cast<uint64_t>(std::stod(text)) != id)
+            ++stod_lossy;
+        if (Jpp::Json::from_number(text).as_uint64() != id)
+            ++jpp_lossy;
+    }
+
+    std::cout << "numbers:              " << count << " (" << corpus.json.size() << " bytes)\n";
+    std::cout << "stod:                 " << stod_ns / count << " ns/number\n";
+    std::cout << "from_chars:           " << from_chars_ns / count << " ns/number\n";
+    std::cout << "speedup:              " << stod_ns / from_chars_ns << "x\n";
+    std::cout << "parse:                " << corpus.json.size() / parse_ns * 1e3 << " MB/s\n";
+    std::cout << "serialize %f:         " << fixed_output.size() << " bytes, " << fixed_output.size() / fixed_ns * 1e3
+              << " MB/s, " << values.size() / fixed_ns * 1e3 << " M numbers/s, " << fixed_lossy << " lossy\n";
+    std::cout << "serialize shortest:   " << shortest_output.size() << " bytes, " << shortest_output.size() / shortest_ns * 1e3
+              << " MB/s, " << values.size() / shortest_ns * 1e3 << " M numbers/s, " << shortest_lossy << " lossy\n";
+    std::cout << "ids above 2^53 lossy: stod " << stod_lossy << "/" << corpus.ids.size()
+              << ", jpp " << jpp_lossy << "/" << corpus.ids.size() << std::endl;
+    return 0;
+}
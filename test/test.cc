@@ -1,11 +1,54 @@
+#define JPP_STATS
 #include "jpp.hh"
 #include <fstream>
 #include <sstream>
 #include <iostream>
-#include <ctime>
 
 std::string read_string_from_file(const std::string &);
 
+struct ServletCounter : Jpp::Handler
+{
+    int servlets = 0;
+    int numbers = 0;
+    bool in_name = false;
+
+    bool on_key(std::string_view key)
+    {
+        in_name = key == "servlet-name";
+        return key != "taglib";
+    }
+
+    bool on_string(std::string_view)
+    {
+        servlets += in_name;
+        return true;
+    }
+
+    bool on_number(const Jpp::Json &)
+    {
+        ++numbers;
+        return true;
+    }
+};
+
+struct Question
+{
+    std::string question;
+    std::vector<std::string> options;
+    std::string answer;
+};
+JPP_FIELDS(Question, question, options, answer)
+
+struct Person
+{
+    std::string name;
+    int age = 0;
+    std::optional<double> height;
+    std::vector<Person> friends;
+    Jpp::Json extra;
+};
+JPP_FIELDS(Person, name, age, height, friends, extra)
+
 int main(int argc, char **argv)
 {
     try
@@ -15,6 +58,9 @@ int main(int argc, char **argv)
         json.parse(read_string_from_file("json/e1.json"));
         std::cout << json.to_string() << "\n"
                   << std::endl;
+        Jpp::Json mapped_file;
+        mapped_file.parse_file("json/e1.json");
+        std::cout << (mapped_file.to_string() == json.to_string()) << std::endl;
         std::cout << json["quiz"]["maths"].to_string() << "\n"
                   << std::endl;
         json["hello"] = "world";
@@ -53,6 +99,11 @@ int main(int argc, char **argv)
             std::cout << a.second.to_string() << std::endl;
         }
 
+        for (Jpp::Json &element : array.get_array())
+            element = std::vector<Jpp::Json>{std::move(element)};
+        std::cout << array.to_string() << " " << json.get_object().size() << std::endl;
+        array.parse("[1, 2, 3, \"Hello World\"]");
+
         std::vector<Jpp::Json> to_vector = array.get_vector();
         for (auto a : to_vector)
         {
@@ -60,49 +111,182 @@ int main(int argc, char **argv)
         }
         std::cout << std::endl;
 
-        Jpp::Json e2;
-        std::string large_json = read_string_from_file("json/large.json");
+        Jpp::Json numbers;
+        numbers.parse("[0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11]");
+        numbers.reserve(16);
+        numbers.push_back(Jpp::Json(12.0));
+        numbers[14] = "end";
+        std::cout << numbers.to_string() << std::endl;
+        Jpp::Json exact;
+        exact.parse("[-5, 9007199254740993, 18446744073709551615, 1.5e3]");
+        std::cout << exact.to_string() << " " << exact[1].as_int64() << " " << exact[2].as_uint64() << std::endl;
+        std::cout << numbers[11].as_double() << " " << numbers[14].as_string_view() << " "
+                  << json["quiz"]["maths"]["difficult"].as_bool() << std::endl;
+
         std::string e2_json = read_string_from_file("json/e2.json");
-        time_t t1, t2;
+        Jpp::CountingResource counter;
+        Jpp::Json counted;
+        counted.parse(e2_json, &counter);
+        Jpp::Document document;
+        Jpp::Json &root = document.parse(e2_json);
+        std::cout << root["web-app"]["servlet"][0]["servlet-name"].as_string_view() << " "
+                  << counter.get_allocation_count() << " heap allocations, "
+                  << document.get_allocation_count() << " arena chunks" << std::endl;
+        for (int i = 0; i < 3; ++i)
+            document.parse(e2_json).to_string();
+        std::cout << document.get_allocation_count() << " arena chunks when parsed again" << std::endl;
+
+        std::string e1_json = read_string_from_file("json/e1.json");
+        Jpp::Json borrowed;
+        borrowed.parse(e1_json, Jpp::ParseOptions{.borrow_strings = true});
+        std::cout << borrowed["quiz"]["sport"]["q1"]["answer"].as_string_view() << std::endl;
+        Jpp::Json &mapped = document.open("json/e1.json", Jpp::ParseOptions{.borrow_strings = true});
+        std::cout << mapped["quiz"]["maths"]["q2"]["question"].as_string_view() << std::endl;
+        borrowed.parse("{\"escaped\": \"tab\\tquote\\\"\"}", Jpp::ParseOptions{.borrow_strings = true});
+        std::cout << borrowed.to_string() << std::endl;
+
+        Jpp::Json nested;
+        nested.parse(" \n[{}, [], {\"empty\": {}}]");
+        std::cout << nested.to_string() << " " << (Jpp::Scanner::get_simd_level() != Jpp::SIMD_SCALAR) << std::endl;
+        nested.write(std::cout);
+        std::cout << std::endl;
+
+        ServletCounter servlet_counter;
+        bool completed = Jpp::Json::read(e2_json, servlet_counter);
+        std::cout << servlet_counter.servlets << " servlets, " << servlet_counter.numbers << " numbers, completed: " << completed << std::endl;
+
+        Jpp::JsonLines lines("{\"id\": 1, \"tags\": [\"a\"]}\n\n{\"id\": 2}\n{\"id\": 3, \"tags\": []}\n", 2, 16);
+        int64_t id_sum = 0;
+        lines.for_each([&id_sum](Jpp::Json &record)
+                       { id_sum += record["id"].as_int64(); });
+        std::cout << "ids: " << id_sum << std::endl;
+
+        Jpp::Builder builder;
+        Jpp::PushParser<Jpp::Builder> push_parser(builder);
+        for (size_t i = 0; i < e2_json.length(); i += 7)
+            push_parser.feed(e2_json.substr(i, 7));
+        push_parser.finish();
+        std::cout << builder.get_root()["web-app"]["servlet"][4]["servlet-name"].as_string_view() << std::endl;
 
-        std::cout << "started parse loop test" << std::endl;
-        t1 = time(0);
-        for (int i = 0; i < 1'000; i++)
+        Jpp::Json parallel;
+        parallel.parse("[1, {\"a\": [2, 3]}, \"four\", [5], null, 6.5, true, {}]", Jpp::ParseOptions{.threads = 3, .chunk_size = 8});
+        std::cout << parallel.to_string() << std::endl;
+
+        Jpp::KeyPool keys;
+        Jpp::Json ordered;
+        ordered.parse("{\"z\": 1, \"a\": {\"z\": 2, \"a\": 3}}", Jpp::ParseOptions{.keep_order = true, .keys = &keys});
+        std::cout << ordered.to_string() << " " << ordered["a"]["z"].as_int64() << " " << keys.size() << " keys" << std::endl;
+
+        Jpp::Path answers("$.quiz.*.q1.answer");
+        Jpp::Path options("$.quiz.maths['q2'].options[-3:]");
+        Jpp::Path pointer("/quiz/maths/q1/options/2");
+        for (Jpp::Json &answer : answers.evaluate(e1_json))
+            std::cout << answer.as_string_view() << " ";
+        for (Jpp::Json &option : options.evaluate(e1_json))
+            std::cout << option.as_string_view() << " ";
+        std::cout << pointer.evaluate(e1_json)[0].as_string_view() << " " << pointer.find(json)->as_string_view() << " "
+                  << options.select(json).size() << " " << (Jpp::Path("/quiz/none").find(json) == nullptr) << std::endl;
+
+        Question question = Jpp::Binder::decode<Question>(Jpp::Path("/quiz/maths/q1").find(json)->to_string());
+        Person person = Jpp::Binder::decode<Person>("{\"name\": \"Simon\", \"unknown\": [1, {}], \"age\": 20, \"height\": null, "
+                                                    "\"friends\": [{\"name\": \"Fr\\\"ank\", \"height\": 1.8}], \"extra\": {\"a\": [true]}}");
+        std::cout << question.options[2] << " " << question.answer << " " << Jpp::Binder::encode(person) << std::endl;
+
+        Jpp::Json cached = Jpp::Json::from_binary(json.to_binary());
+        Jpp::Json binary_numbers;
+        binary_numbers.parse("[-5, 9007199254740993, 18446744073709551615, 1.5e3, \"\", null]");
+        std::cout << (cached.to_string() == json.to_string()) << " " << Jpp::Json::from_binary(binary_numbers.to_binary()).to_string() << " "
+                  << Jpp::Json::from_binary(ordered.to_binary()).to_string() << std::endl;
+
+        Jpp::Json escaped;
+        escaped.parse("[\"caf\\u00e9 \\ud83d\\ude00 \\ud800 \\/ \\f\", \"tab\\tquote\\\"back\\\\slash\\u0001 and a run longer than sixteen bytes\"]");
+        std::cout << escaped[0].as_string_view() << " " << escaped.to_string() << std::endl;
+
+        Jpp::FrozenDocument frozen(e1_json, Jpp::ParseOptions(), true);
+        std::pmr::monotonic_buffer_resource frozen_arena;
+        Jpp::Json arena_json;
+        arena_json.parse(e1_json, Jpp::ParseOptions(), &frozen_arena);
+        Jpp::FrozenDocument pooled(arena_json, true);
+        Jpp::Document shared_document;
+        const Jpp::Json &shared_root = shared_document.parse(e1_json);
+        std::vector<std::thread> readers;
+        std::atomic<size_t> answers_read = 0;
+        for (int i = 0; i < 4; ++i)
+            readers.emplace_back([&frozen, &pooled, &shared_root, &answers_read, i]()
+                                 {
+                const Jpp::Json &quiz = frozen.get_root()["quiz"];
+                answers_read += quiz["maths"]["q2"]["answer"].as_string_view() == "4";
+                answers_read += quiz.find("history") == nullptr && quiz.at("sport").size() == 1;
+                const char *subject = i % 2 ? "maths" : "sport";
+                answers_read += pooled.get_root()["quiz"][subject]["q1"]["options"].size() == 4;
+                answers_read += shared_root["quiz"][subject]["q1"]["answer"].as_string_view().size() > 0; });
+        for (std::thread &reader : readers)
+            reader.join();
+        std::cout << answers_read << " frozen reads " << frozen.get_root()["quiz"]["sport"].to_string() << std::endl;
+
+        Jpp::Stats stats;
         {
-            e2.parse(e2_json);
+            Jpp::StatsScope scope(stats);
+            Jpp::Json measured;
+            measured.parse("{\"a\": [1, 2.5, {\"b\": [true, null]}], \"c\": \"text\"}");
+            measured.to_string();
+            Jpp::Json lazy;
+            lazy.parse(e1_json, Jpp::ParseOptions{.borrow_strings = true});
+            lazy["quiz"]["maths"].size();
         }
-        t2 = time(0);
-        std::cout << t2 - t1 << "s" << std::endl;
-
-        std::cout << "started large json test" << std::endl;
-        t1 = time(0);
-        e2.parse(large_json);
-        t2 = time(0);
-        std::cout << t2 - t1 << "s" << std::endl;
-
-        std::cout << "started large json serialization test" << std::endl;
-        t1 = time(0);
-        e2.to_string();
-        t2 = time(0);
-        std::cout << t2 - t1 << "s" << std::endl;
-
-        std::cout << "started large array access loop test" << std::endl;
-        t1 = time(0);
-        for (int i = 0; i < 1'000; i++)
+        size_t callbacks = 0;
         {
-            auto x = e2[i];
+            Jpp::StatsScope scope([&callbacks](const Jpp::Stats &inner)
+                                  { callbacks += inner.objects; });
+            Jpp::Json inner;
+            inner.parse("{\"x\": {}}");
         }
-        t2 = time(0);
-        std::cout << t2 - t1 << "s" << std::endl;
+        std::cout << stats.objects << " objects " << stats.arrays << " arrays " << stats.numbers << " numbers " << stats.max_depth << " depth "
+                  << stats.lazy_materializations << " lazy " << stats.bytes_written << " written " << callbacks << " callback objects" << std::endl;
 
-        std::cout << "started for each loop and serialization test" << std::endl;
-        t1 = time(0);
-        for (auto c : e2)
+        Jpp::CountingResource heap;
+        std::pmr::memory_resource *previous_default = std::pmr::set_default_resource(&heap);
         {
-            c.second.to_string();
+            std::pmr::monotonic_buffer_resource arena(1 << 16, std::pmr::new_delete_resource());
+            Jpp::Json request(&arena);
+            request.parse(e1_json, Jpp::ParseOptions(), &arena);
+            Jpp::Json copy(std::allocator_arg, &arena, request["quiz"]["maths"]);
+            copy["q3"] = "added";
+            request["quiz"]["sport"]["q1"]["options"].push_back(Jpp::Json(std::allocator_arg, &arena, "Lakers"));
+            std::pmr::vector<Jpp::Json> list(&arena);
+            list.emplace_back(copy);
+            list.emplace_back(2.5);
+            std::pmr::string out(&arena);
+            Jpp::Handler events;
+            list[0].write(out);
+            Jpp::Json::read(out, events, &arena);
+            std::string encoded = Jpp::Binder::encode(person);
+            std::vector<Jpp::Json> escaped_names = Jpp::Path("$['a property with a long name']").evaluate("{\"a property\\u0020with a long name\": 7}", Jpp::ParseOptions(), &arena);
+            std::cout << heap.get_allocation_count() << " default allocations " << escaped_names[0].as_int64() << " " << (list[0].get_resource() == &arena) << " "
+                      << list[0]["q3"].as_string_view() << " " << request["quiz"]["sport"]["q1"]["options"].size() << std::endl;
         }
-        t2 = time(0);
-        std::cout << t2 - t1 << "s" << std::endl;
+        std::pmr::set_default_resource(previous_default);
+
+        Jpp::Json parent;
+        parent.parse("{\"a\": {\"b\": [1, {\"c\": \"deep\"}]}, \"z\": 0}");
+        parent = std::move(parent["a"]);
+        parent = std::move(parent["b"]);
+        parent = std::move(parent[1]);
+        std::cout << parent.to_string() << std::endl;
+        parent.parse("{\"a\": [{\"b\": \"copied\"}, 2], \"z\": 0}");
+        parent = parent["a"];
+        parent = parent[0];
+        std::cout << parent.to_string() << std::endl;
+        parent.parse("[\"first\", 2]");
+        parent[5] = parent[0];
+        std::cout << parent.to_string() << std::endl;
+        parent.parse("{\"b\": \"second\", \"z\": 0}");
+        parent["a"] = parent["b"];
+        Jpp::Json &held = parent["x"];
+        for (int i = 0; i < 20; ++i)
+            parent["k" + std::to_string(i)] = i;
+        held = "hello";
+        std::cout << parent["a"].as_string_view() << " " << parent["x"].as_string_view() << " " << parent.size() << std::endl;
 
         // Jpp::Json literal_array = l_array{1, "wow", 5, 10.234, "hello"};
         // std::cout << literal_array.to_string() << std::endl;
@@ -110,11 +294,11 @@ int main(int argc, char **argv)
         // Jpp::Json literal_object = l_object{{"name", "Franz"}, {"surname", "Kafka"}, {"birth", 1883}};
         // std::cout << literal_object.to_string() << std::endl;
     }
-    catch (const std::exception e)
+    catch (const std::exception &e)
     {
         std::cout << e.what() << std::endl;
+        return 1;
     }
-    system("PAUSE");
     return 0;
 }
 